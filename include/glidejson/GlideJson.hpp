@@ -24,14 +24,36 @@ extern "C" {
 }
 
 #include <stdexcept>
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <limits>
+#include <functional>
+#include <algorithm>
+#include <fstream>
 #include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
 #include <random>
 #include <unordered_map>
 #include <list>
 #include <map>
+#include <memory>
 #include <string>
+#include <thread>
 #include <vector>
 
+#if defined(__unix__) || defined(__APPLE__)
+  #define GLIDE_JSON_POSIX
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
 #define SIP_HASH_SECRET_SIZE 16
 #define GLIDE_BYTE_SIZE 256
 #define GLIDE_BYTE_WIDTH 8
@@ -266,6 +288,23 @@ typedef std::conditional<
 
 // ========================================
 
+/*
+  An entry of "GlideHashMap" in insertion order. It's a class of its own
+  so that a map of a particular type can keep more with each key (see
+  the one for GlideJson).
+*/
+template<class T>
+class GlideHashMapEntry : public std::pair< GlideSortItem<std::string>, GlideItem<T> > {
+  public:
+    GlideHashMapEntry(GlideSortItem<std::string> &&key, const GlideItem<T> &value);
+};
+
+template<class T>
+GlideHashMapEntry<T>::GlideHashMapEntry(GlideSortItem<std::string> &&key, const GlideItem<T> &value) : std::pair< GlideSortItem<std::string>, GlideItem<T> >(std::move(key), value) {
+}
+
+// ========================================
+
 template<class T>
 class GlideHashMapIterator {
   private:
@@ -282,6 +321,7 @@ class GlideHashMapIterator {
     void previous();
     auto key() const -> decltype(iterator->first.value());
     auto value() const -> decltype(iterator->second.value());
+    auto entry() const -> decltype(*iterator);
 };
 
 template<class T>
@@ -336,13 +376,18 @@ auto GlideHashMapIterator<T>::value() const -> decltype(iterator->second.value()
   return iterator->second.value();
 }
 
+template<class T>
+auto GlideHashMapIterator<T>::entry() const -> decltype(*iterator) {
+  return *iterator;
+}
+
 // ========================================
 
 template<class T>
 class GlideHashMap {
   public:
     typedef GlideSortItem<std::string> Key;
-    typedef std::pair< Key, GlideItem<T> > KeyPair;
+    typedef GlideHashMapEntry<T> KeyPair;
   private:
     std::list<KeyPair> positionList;
   public:
@@ -370,6 +415,7 @@ class GlideHashMap {
     T & operator[](std::string &&key);
     size_t erase(const std::string &key);
     void clear();
+    void splice(GlideHashMap &input);
     void sort();
     void rsort();
     auto begin() const -> GlideHashMapIterator<decltype(positionList.begin())>;
@@ -503,6 +549,33 @@ void GlideHashMap<T>::clear() {
   positionList.clear();
 }
 
+/*
+  Moves every entry of "input" to the end of this map, leaving "input"
+  empty. The entries themselves are relinked rather than copied, so only
+  the index has to learn of them. A key this map already has keeps its
+  position and takes the value from "input", as if it had been assigned.
+*/
+template<class T>
+void GlideHashMap<T>::splice(GlideHashMap<T> &input) {
+  if(input.positionList.empty()) {
+    return;
+  }
+  auto i(input.positionList.begin());
+  auto iEnd(positionList.end());
+  positionList.splice(iEnd, input.positionList);
+  input.hashMap.clear();
+  while(i != iEnd) {
+    auto result(hashMap.emplace(i->first, ValuePair(Position(true, i), i->second)));
+    if(result.second) {
+      ++i;
+    }
+    else {
+      result.first->second.second.value() = std::move(i->second.value());
+      i = positionList.erase(i);
+    }
+  }
+}
+
 template<class T>
 void GlideHashMap<T>::sort() {
   positionList.sort(GlideHashMap::lessThan);
@@ -576,6 +649,17 @@ class GlideString {
   public:
     static inline void initialize(const size_t &inputSize, size_t &inputCapacity, std::string &input);
     static inline void append(const unsigned char &inputChar, size_t &inputSize, size_t &inputCapacity, std::string &input);
+    static inline void append(const char *inputChars, const size_t &inputLength, size_t &inputSize, size_t &inputCapacity, std::string &input);
+};
+
+// ========================================
+
+class GlideScan {
+  public:
+    static inline size_t whitespace(const char *input, size_t index, size_t size);
+    static inline size_t digits(const char *input, size_t index, size_t size);
+    static inline size_t verbatim(const char *input, size_t index, size_t size);
+    static inline size_t structural(const char *input, size_t index, size_t size);
 };
 
 // ========================================
@@ -588,16 +672,27 @@ namespace GlideJsonScheme {
   class Boolean;
   class Number;
   class String;
+  class StringView;
+  class Remembered;
   class Array;
   class Object;
   class Parser;
+  class Selection;
 }
 
+class GlideJsonHandler;
+class GlideJsonSelector;
+class GlideJsonLimits;
+class GlideJsonArrayReader;
+class GlideJsonSink;
+class GlideJsonStyle;
+
 class GlideJson {
   friend class GlideJsonScheme::Number;
   friend class GlideJsonScheme::Array;
   friend class GlideJsonScheme::Object;
   friend class GlideJsonScheme::Parser;
+  friend class GlideJsonScheme::Selection;
   public:
     enum Type { Error, Null, Boolean, Number, String, Array, Object };
     enum Whitespace { SpaceLf, TabLf, SpaceCrlf, TabCrlf };
@@ -614,6 +709,7 @@ class GlideJson {
     explicit GlideJson(unsigned int input);
     explicit GlideJson(long int input);
     explicit GlideJson(long unsigned int input);
+    explicit GlideJson(double input);
     explicit GlideJson(size_t count, char input);
     explicit GlideJson(const char *input);
     explicit GlideJson(const char *input, size_t size);
@@ -628,6 +724,7 @@ class GlideJson {
     GlideJson & operator=(unsigned int input);
     GlideJson & operator=(long int input);
     GlideJson & operator=(unsigned long int input);
+    GlideJson & operator=(double input);
     bool setNumber(const std::string &input);
     bool setNumber(const char *input, size_t size);
     GlideJson & setString(size_t count, char input);
@@ -635,9 +732,6 @@ class GlideJson {
     GlideJson & setString(const char *input, size_t size);
     GlideJson & operator=(const std::string &input);
     GlideJson & operator=(std::string &&input);
-  private:
-    std::string toJson(GlideJson::Whitespace type, size_t depth) const;
-  public:
     GlideJson::Type getType() const;
     bool isError() const;
     bool isNull() const;
@@ -655,6 +749,21 @@ class GlideJson {
     bool notObject() const;
     std::string toJson() const;
     std::string toJson(GlideJson::Whitespace type) const;
+    std::string toJson(const GlideJsonStyle &style) const;
+    void toJson(std::string &output) const;
+    void toJson(std::string &output, GlideJson::Whitespace type) const;
+    void toJson(std::string &output, const GlideJsonStyle &style) const;
+    bool toJson(GlideJsonSink &output) const;
+    bool toJson(GlideJsonSink &output, GlideJson::Whitespace type) const;
+    bool toJson(GlideJsonSink &output, const GlideJsonStyle &style) const;
+    size_t toJson(char *output, size_t capacity) const;
+    size_t toJson(char *output, size_t capacity, GlideJson::Whitespace type) const;
+    size_t toJson(char *output, size_t capacity, const GlideJsonStyle &style) const;
+    size_t measureJson() const;
+    size_t measureJson(GlideJson::Whitespace type) const;
+    size_t measureJson(const GlideJsonStyle &style) const;
+    void rememberJson(bool input);
+    void rememberJsonTree(bool input);
     const std::string & error() const;
     const bool & boolean() const;
     const std::string & number() const;
@@ -665,6 +774,14 @@ class GlideJson {
     unsigned int toUInt() const;
     long int toLong() const;
     unsigned long int toULong() const;
+    bool toInt(int &output) const;
+    bool toUInt(unsigned int &output) const;
+    bool toLong(long int &output) const;
+    bool toULong(unsigned long int &output) const;
+    double toDouble() const;
+    float toFloat() const;
+    bool toDouble(double &output) const;
+    bool toFloat(float &output) const;
     bool & boolean();
     std::string & string();
     std::vector<GlideJson> & array();
@@ -672,6 +789,24 @@ class GlideJson {
     static unsigned char getHex(unsigned char input);
     static GlideJson parse(const std::string &input);
     static GlideJson parse(const char *input, size_t size);
+    static GlideJson parse(const std::string &input, GlideJsonHandler &handler);
+    static GlideJson parse(const char *input, size_t size, GlideJsonHandler &handler);
+    static GlideJson parse(const std::string &input, const GlideJsonSelector &selector);
+    static GlideJson parse(const char *input, size_t size, const GlideJsonSelector &selector);
+    static GlideJson parse(const std::string &input, const GlideJsonLimits &limits);
+    static GlideJson parse(const char *input, size_t size, const GlideJsonLimits &limits);
+    static GlideJson parseShared(const std::shared_ptr<const std::string> &input);
+    static GlideJson parseShared(std::string &&input);
+    static GlideJson parseFile(const std::string &path);
+    static GlideJson parseFileShared(const std::string &path);
+    static GlideJson parseInParallel(const std::string &input, size_t threads);
+    static GlideJson parseInParallel(const char *input, size_t size, size_t threads);
+    static bool parseInto(GlideJson &target, const std::string &input);
+    static bool parseInto(GlideJson &target, const char *input, size_t size);
+    static bool validate(const std::string &input);
+    static bool validate(const char *input, size_t size);
+    static bool validate(const std::string &input, size_t &index);
+    static bool validate(const char *input, size_t size, size_t &index);
     static std::string encodeString(const std::string &input);
     static std::string encodeString(const char *input, size_t size);
     static std::string base64Encode(const std::string &input);
@@ -680,6 +815,359 @@ class GlideJson {
     static std::string base64Decode(const char *input, size_t size);
 };
 
+// ========================================
+
+/*
+  The entries of a JSON object also keep the key's JSON encoding, so
+  serializing the object again copies it verbatim. Keys never change in
+  place (a different key is a different entry), so the memo can only go
+  stale through a copy, which carries it over only once it's complete.
+  "memoized" is 0 until something claims the memo, 1 while it's being
+  written, and 2 once it's ready.
+*/
+template<>
+class GlideHashMapEntry<GlideJson> : public std::pair< GlideSortItem<std::string>, GlideItem<GlideJson> > {
+  public:
+    mutable std::atomic<unsigned char> memoized;
+    mutable std::string memo;
+    GlideHashMapEntry(GlideSortItem<std::string> &&key, const GlideItem<GlideJson> &value);
+    GlideHashMapEntry(const GlideHashMapEntry &input);
+    ~GlideHashMapEntry();
+    GlideHashMapEntry & operator=(const GlideHashMapEntry &input);
+};
+
+// ========================================
+
+class GlideJsonLimits {
+  public:
+    size_t depth;
+    size_t length;
+    size_t nodes;
+    size_t bytes;
+    GlideJsonLimits();
+};
+
+// ========================================
+
+class GlideJsonParser {
+  friend class GlideJsonScheme::Parser;
+  private:
+    unsigned char state;
+    unsigned short unicode;
+    size_t offset;
+    size_t finalIndex;
+    GlideJson output;
+    GlideJson *cOutput;
+    std::string *decoded;
+    size_t decodedSize;
+    size_t decodedCapacity;
+    std::string scratch;
+    GlideJson objectKey;
+    std::vector<GlideJson *> containers;
+    GlideJsonLimits limits;
+    size_t nodes;
+    size_t bytes;
+    unsigned char exceeded;
+  public:
+    GlideJsonParser();
+    GlideJsonParser(const GlideJsonLimits &limits);
+    GlideJsonParser(const GlideJsonParser &input);
+    ~GlideJsonParser();
+    GlideJsonParser & operator=(const GlideJsonParser &input);
+    void reset();
+    void setLimits(const GlideJsonLimits &limits);
+    bool feed(const std::string &input);
+    bool feed(const char *input, size_t size);
+    GlideJson finish();
+    GlideJson parse(const std::string &input);
+    GlideJson parse(const char *input, size_t size);
+};
+
+// ========================================
+
+class GlideJsonHandler {
+  public:
+    GlideJsonHandler();
+    virtual ~GlideJsonHandler();
+    virtual void onNull();
+    virtual void onBoolean(bool input);
+    virtual void onNumber(const char *input, size_t size);
+    virtual void onString(const char *input, size_t size);
+    virtual void onKey(const char *input, size_t size);
+    virtual void onStartArray();
+    virtual void onEndArray();
+    virtual void onStartObject();
+    virtual void onEndObject();
+};
+
+// ========================================
+
+class GlideJsonLines {
+  private:
+    size_t threads;
+    static void split(const char *input, size_t size, std::vector<size_t> &lines);
+    void parseBatch(const char *input, const std::vector<size_t> &lines, std::vector<GlideJson> &output) const;
+    size_t parse(const char *input, size_t size, size_t line, const std::function<void(size_t, GlideJson &)> &callback) const;
+  public:
+    GlideJsonLines();
+    GlideJsonLines(size_t threads);
+    GlideJsonLines(const GlideJsonLines &input);
+    ~GlideJsonLines();
+    GlideJsonLines & operator=(const GlideJsonLines &input);
+    std::vector<GlideJson> parse(const std::string &input) const;
+    std::vector<GlideJson> parse(const char *input, size_t size) const;
+    void parse(const std::string &input, const std::function<void(size_t, GlideJson &)> &callback) const;
+    void parse(const char *input, size_t size, const std::function<void(size_t, GlideJson &)> &callback) const;
+    bool parseFile(const std::string &path, const std::function<void(size_t, GlideJson &)> &callback) const;
+};
+
+// ========================================
+
+class GlideJsonArrayReader {
+  friend class GlideJsonScheme::Parser;
+  private:
+    enum Stage { Opening, First, Element, Closed, Done };
+    int descriptor;
+    std::istream *stream;
+    std::string buffer;
+    size_t filled;
+    size_t position;
+    size_t offset;
+    size_t depth;
+    GlideJsonArrayReader::Stage stage;
+    bool quoted;
+    bool escaped;
+    bool unreadable;
+    GlideJsonParser parser;
+    bool fill();
+    GlideJsonArrayReader(const GlideJsonArrayReader &input);
+    GlideJsonArrayReader & operator=(const GlideJsonArrayReader &input);
+  public:
+    GlideJsonArrayReader(std::istream &stream);
+    GlideJsonArrayReader(std::istream &stream, size_t capacity);
+    #ifdef GLIDE_JSON_POSIX
+    GlideJsonArrayReader(int descriptor);
+    GlideJsonArrayReader(int descriptor, size_t capacity);
+    #endif
+    ~GlideJsonArrayReader();
+    bool next(GlideJson &output);
+};
+
+// ========================================
+
+class GlideJsonSink {
+  friend class GlideJson;
+  friend class GlideJsonScheme::Encoder;
+  friend class GlideJsonScheme::Remembered;
+  private:
+    int descriptor;
+    std::ostream *stream;
+    std::function<bool(const char *, size_t)> callback;
+    std::string *target;
+    std::string buffer;
+    char *data;
+    size_t filled;
+    size_t capacity;
+    size_t drained;
+    bool bounded;
+    bool failed;
+    void drain();
+    GlideJsonSink(std::string &target);
+    GlideJsonSink(char *memory, size_t capacity);
+    GlideJsonSink(const GlideJsonSink &input);
+    GlideJsonSink & operator=(const GlideJsonSink &input);
+  public:
+    GlideJsonSink(std::ostream &stream);
+    GlideJsonSink(std::ostream &stream, size_t capacity);
+    GlideJsonSink(const std::function<bool(const char *, size_t)> &callback);
+    GlideJsonSink(const std::function<bool(const char *, size_t)> &callback, size_t capacity);
+    #ifdef GLIDE_JSON_POSIX
+    GlideJsonSink(int descriptor);
+    GlideJsonSink(int descriptor, size_t capacity);
+    #endif
+    ~GlideJsonSink();
+    inline void append(unsigned char input);
+    inline void append(const char *input, size_t size);
+    bool flush();
+};
+
+/*
+  Every value is appended through these, so they're defined here to be
+  inlined. A capacity of 0 means caller memory ran out, and from then on
+  the output is only counted.
+*/
+
+inline void GlideJsonSink::append(unsigned char input) {
+  if(filled == capacity) {
+    if(capacity) {
+      drain();
+    }
+    if(!capacity) {
+      ++drained;
+      return;
+    }
+  }
+  data[filled++] = input;
+}
+
+inline void GlideJsonSink::append(const char *input, size_t size) {
+  size_t room(capacity - filled);
+  while(size > room) {
+    if(!capacity) {
+      drained += size;
+      return;
+    }
+    std::memcpy(data + filled, input, room);
+    filled = capacity;
+    input += room;
+    size -= room;
+    drain();
+    room = capacity - filled;
+  }
+  std::memcpy(data + filled, input, size);
+  filled += size;
+}
+
+// ========================================
+
+class GlideJsonStyle {
+  friend class GlideJsonScheme::Array;
+  friend class GlideJsonScheme::Object;
+  private:
+    inline void newLine(GlideJsonSink &output, size_t depth) const;
+  public:
+    size_t width;
+    bool tabs;
+    bool crlf;
+    size_t inlineArrays;
+    GlideJsonStyle();
+    GlideJsonStyle(GlideJson::Whitespace type);
+};
+
+// ========================================
+
+namespace GlideJsonScheme {
+  class Selection;
+
+  class SelectorNode {
+    public:
+      std::unordered_map<std::string, size_t> children;
+      size_t wildcard;
+      bool selected;
+  };
+}
+
+class GlideJsonSelector {
+  friend class GlideJsonScheme::Selection;
+  private:
+    std::vector<GlideJsonScheme::SelectorNode> nodes;
+    size_t addNode();
+    bool find(size_t parent, const std::string &key, size_t &node) const;
+  public:
+    GlideJsonSelector();
+    GlideJsonSelector(const std::vector<std::string> &paths);
+    GlideJsonSelector(const GlideJsonSelector &input);
+    ~GlideJsonSelector();
+    GlideJsonSelector & operator=(const GlideJsonSelector &input);
+    void add(const std::string &path);
+};
+
+// ========================================
+
+namespace GlideJsonScheme {
+  class TapeEntry {
+    public:
+      unsigned char type;
+      unsigned char flag;
+      size_t offset;
+      size_t size;
+      size_t count;
+      size_t next;
+  };
+}
+
+class GlideJsonView;
+
+class GlideJsonTape {
+  friend class GlideJsonScheme::Parser;
+  friend class GlideJsonView;
+  friend class GlideJsonViewIterator;
+  private:
+    const char *input;
+    std::vector<GlideJsonScheme::TapeEntry> tape;
+  public:
+    GlideJsonTape();
+    GlideJsonTape(const GlideJsonTape &input);
+    ~GlideJsonTape();
+    GlideJsonTape & operator=(const GlideJsonTape &input);
+    GlideJson parse(const std::string &input);
+    GlideJson parse(std::string &&input) = delete;
+    GlideJson parse(const char *input, size_t size);
+    GlideJsonView root() const;
+};
+
+class GlideJsonViewIterator {
+  friend class GlideJsonView;
+  private:
+    const GlideJsonTape *tape;
+    size_t index;
+    bool object;
+    GlideJsonViewIterator(const GlideJsonTape *tape, size_t index, bool object);
+  public:
+    GlideJsonViewIterator();
+    bool operator==(const GlideJsonViewIterator &input) const;
+    bool operator!=(const GlideJsonViewIterator &input) const;
+    void next();
+    std::string key() const;
+    GlideJsonView value() const;
+};
+
+class GlideJsonView {
+  friend class GlideJsonTape;
+  friend class GlideJsonViewIterator;
+  private:
+    const GlideJsonTape *tape;
+    size_t index;
+    GlideJsonView(const GlideJsonTape *tape, size_t index);
+    const GlideJsonScheme::TapeEntry & entry() const;
+    bool matches(size_t keyIndex, const std::string &key) const;
+    GlideJsonScheme::Number binary() const;
+  public:
+    GlideJsonView();
+    GlideJson::Type getType() const;
+    bool isError() const;
+    bool isNull() const;
+    bool isBoolean() const;
+    bool isNumber() const;
+    bool isString() const;
+    bool isArray() const;
+    bool isObject() const;
+    bool boolean() const;
+    std::string number() const;
+    std::string string() const;
+    int toInt() const;
+    unsigned int toUInt() const;
+    long int toLong() const;
+    unsigned long int toULong() const;
+    bool toInt(int &output) const;
+    bool toUInt(unsigned int &output) const;
+    bool toLong(long int &output) const;
+    bool toULong(unsigned long int &output) const;
+    double toDouble() const;
+    float toFloat() const;
+    bool toDouble(double &output) const;
+    bool toFloat(float &output) const;
+    size_t size() const;
+    size_t count(const std::string &key) const;
+    GlideJsonView at(size_t position) const;
+    GlideJsonView at(const std::string &key) const;
+    GlideJsonView operator[](size_t position) const;
+    GlideJsonView operator[](const std::string &key) const;
+    GlideJsonViewIterator begin() const;
+    GlideJsonViewIterator end() const;
+    GlideJson toGlideJson() const;
+};
+
 namespace GlideJsonScheme {
 
   class EncoderInitializer;
@@ -702,6 +1190,8 @@ namespace GlideJsonScheme {
       Encoder & operator=(const Encoder &input);
       static std::string encode(const std::string &input);
       static std::string encode(const char *cInput, size_t size);
+      static void encode(const std::string &input, GlideJsonSink &output);
+      static void encode(const char *cInput, size_t size, GlideJsonSink &output);
       static std::string base64Encode(const std::string &input);
       static std::string base64Encode(const char *cInput, size_t length);
       static std::string base64Decode(const std::string &input);
@@ -726,8 +1216,8 @@ namespace GlideJsonScheme {
       virtual ~Base();
       Base & operator=(const Base &input);
       virtual GlideJson::Type getType() const;
-      virtual std::string toJson() const;
-      virtual std::string toJson(GlideJson::Whitespace type, size_t depth) const;
+      virtual void toJson(GlideJsonSink &output) const;
+      virtual void toJson(GlideJsonSink &output, const GlideJsonStyle &style, size_t depth) const;
       virtual const std::string & theError() const;
       virtual const bool & theBoolean() const;
       virtual bool & theBoolean();
@@ -738,6 +1228,8 @@ namespace GlideJsonScheme {
       virtual std::vector<GlideJson> & theArray();
       virtual const GlideHashMap<GlideJson> & theObject() const;
       virtual GlideHashMap<GlideJson> & theObject();
+      virtual void remember(bool input);
+      virtual void rememberTree(bool input);
       virtual void dispose();
       virtual Base * duplicate() const;
   };
@@ -755,8 +1247,8 @@ namespace GlideJsonScheme {
       Error & operator=(const Error &input);
       Error & operator=(Error &&input);
       virtual GlideJson::Type getType() const;
-      virtual std::string toJson() const;
-      virtual std::string toJson(GlideJson::Whitespace type, size_t depth) const;
+      virtual void toJson(GlideJsonSink &output) const;
+      virtual void toJson(GlideJsonSink &output, const GlideJsonStyle &style, size_t depth) const;
       const std::string & theError() const;
     private:
       static GlideLfs errorCache;
@@ -773,8 +1265,8 @@ namespace GlideJsonScheme {
       virtual ~Null();
       Null & operator=(const Null &input);
       virtual GlideJson::Type getType() const;
-      virtual std::string toJson() const;
-      virtual std::string toJson(GlideJson::Whitespace type, size_t depth) const;
+      virtual void toJson(GlideJsonSink &output) const;
+      virtual void toJson(GlideJsonSink &output, const GlideJsonStyle &style, size_t depth) const;
       static Null * soleNull();
       virtual void dispose();
       virtual Null * duplicate() const;
@@ -789,8 +1281,8 @@ namespace GlideJsonScheme {
       virtual ~Boolean();
       Boolean & operator=(const Boolean &input);
       virtual GlideJson::Type getType() const;
-      virtual std::string toJson() const;
-      virtual std::string toJson(GlideJson::Whitespace type, size_t depth) const;
+      virtual void toJson(GlideJsonSink &output) const;
+      virtual void toJson(GlideJsonSink &output, const GlideJsonStyle &style, size_t depth) const;
       virtual const bool & theBoolean() const;
       virtual bool & theBoolean();
     private:
@@ -803,8 +1295,28 @@ namespace GlideJsonScheme {
 
   class Number : public Base {
     friend class Parser;
+    friend class Selection;
     protected:
       std::string number;
+      uint64_t mantissa;
+      int64_t exponent;
+      uint32_t explicitExponent;
+      bool negative;
+      bool negativeExponent;
+      bool saturated;
+      bool truncated;
+      static const uint64_t powers[20];
+      inline void clear();
+      inline void assign(bool isNegative, uint64_t magnitude);
+      inline void digits(const char *input, size_t size, bool fraction);
+      inline void exponentDigits(const char *input, size_t size);
+      unsigned char integerPart(uint64_t &magnitude) const;
+      static const uint64_t * fives();
+      static inline uint64_t product(uint64_t left, uint64_t right, uint64_t &high);
+      static bool approximate(uint64_t magnitude, int64_t power, int mantissaBits, uint64_t &bits);
+      static inline uint64_t shifted(uint64_t multiplier, uint64_t low, uint64_t high, int64_t shift);
+      static inline bool fiveDivides(uint64_t input, int64_t power);
+      static void shortest(uint64_t bits, uint64_t &digits, int64_t &power);
     public:
       Number();
       Number(const std::string &input);
@@ -812,6 +1324,7 @@ namespace GlideJsonScheme {
       Number(unsigned int input);
       Number(long int input);
       Number(unsigned long int input);
+      Number(double input);
       Number(const Number &input);
       Number(Number &&input);
       virtual ~Number();
@@ -819,14 +1332,20 @@ namespace GlideJsonScheme {
       Number & operator=(unsigned int input);
       Number & operator=(long int input);
       Number & operator=(unsigned long int input);
+      Number & operator=(double input);
       Number & operator=(const Number &input);
       Number & operator=(Number &&input);
       virtual GlideJson::Type getType() const;
-      virtual std::string toJson() const;
-      virtual std::string toJson(GlideJson::Whitespace type, size_t depth) const;
+      virtual void toJson(GlideJsonSink &output) const;
+      virtual void toJson(GlideJsonSink &output, const GlideJsonStyle &style, size_t depth) const;
       virtual const std::string & theNumber() const;
       bool set(const std::string &input);
       bool set(const char *input, size_t size);
+      void scan(const char *input, size_t size);
+      template<class T>
+      unsigned char integer(T &output) const;
+      template<class T>
+      unsigned char floating(T &output, const char *input, size_t size) const;
     private:
       static GlideLfs numberCache;
     public:
@@ -847,8 +1366,8 @@ namespace GlideJsonScheme {
       String & operator=(const String &input);
       String & operator=(String &&input);
       virtual GlideJson::Type getType() const;
-      virtual std::string toJson() const;
-      virtual std::string toJson(GlideJson::Whitespace type, size_t depth) const;
+      virtual void toJson(GlideJsonSink &output) const;
+      virtual void toJson(GlideJsonSink &output, const GlideJsonStyle &style, size_t depth) const;
       virtual const std::string & theString() const;
       virtual std::string & theString();
     private:
@@ -859,9 +1378,86 @@ namespace GlideJsonScheme {
       virtual String * duplicate() const;
   };
 
+  class StringView : public Base {
+    friend class Parser;
+    protected:
+      std::shared_ptr<const void> owner;
+      const char *view;
+      size_t size;
+      mutable std::atomic<unsigned char> materialized;
+      mutable std::string string;
+      void materialize() const;
+    public:
+      StringView();
+      StringView(const StringView &input);
+      virtual ~StringView();
+      StringView & operator=(const StringView &input);
+      virtual GlideJson::Type getType() const;
+      virtual void toJson(GlideJsonSink &output) const;
+      virtual void toJson(GlideJsonSink &output, const GlideJsonStyle &style, size_t depth) const;
+      virtual const std::string & theString() const;
+      virtual std::string & theString();
+    private:
+      static GlideLfs stringViewCache;
+    public:
+      static StringView * make();
+      virtual void dispose();
+      virtual String * duplicate() const;
+  };
+
+  class MappedFile {
+    public:
+      const char *data;
+      size_t size;
+    private:
+      std::string buffer;
+      #ifdef GLIDE_JSON_POSIX
+      bool read(int file);
+      #else
+      bool read(const std::string &path);
+      #endif
+      MappedFile(const MappedFile &input);
+      MappedFile & operator=(const MappedFile &input);
+    public:
+      MappedFile();
+      ~MappedFile();
+      bool open(const std::string &path);
+  };
+
+  class Workers {
+    private:
+      std::function<void()> work;
+      std::vector<std::thread> pool;
+      std::mutex lock;
+      std::exception_ptr failure;
+      void run();
+      Workers(const Workers &input);
+      Workers & operator=(const Workers &input);
+    public:
+      Workers(size_t count, const std::function<void()> &work);
+      ~Workers();
+      size_t size() const;
+      void join();
+  };
+
+  class Remembered {
+    public:
+      mutable std::atomic<unsigned char> state;
+      mutable std::string bytes;
+      Remembered();
+      Remembered(const Remembered &input);
+      ~Remembered();
+    private:
+      Remembered & operator=(const Remembered &input);
+    public:
+      static Remembered * copy(const std::unique_ptr<Remembered> &input);
+      inline bool recall(const Base &owner, GlideJsonSink &output) const;
+  };
+
   class Array : public Base {
     public:
       std::vector<GlideJson> array;
+      std::unique_ptr<Remembered> remembered;
       Array();
       Array(const std::vector<GlideJson> &input);
       Array(const Array &input);
@@ -870,10 +1466,12 @@ namespace GlideJsonScheme {
       Array & operator=(const Array &input);
       Array & operator=(Array &&input);
       virtual GlideJson::Type getType() const;
-      virtual std::string toJson() const;
-      virtual std::string toJson(GlideJson::Whitespace type, size_t depth) const;
+      virtual void toJson(GlideJsonSink &output) const;
+      virtual void toJson(GlideJsonSink &output, const GlideJsonStyle &style, size_t depth) const;
       virtual const std::vector<GlideJson> & theArray() const;
       virtual std::vector<GlideJson> & theArray();
+      virtual void remember(bool input);
+      virtual void rememberTree(bool input);
     private:
       static GlideLfs arrayCache;
     public:
@@ -885,6 +1483,7 @@ namespace GlideJsonScheme {
   class Object : public Base {
     public:
       GlideHashMap<GlideJson> object;
+      std::unique_ptr<Remembered> remembered;
       Object();
       Object(const GlideHashMap<GlideJson> &input);
       Object(const Object &input);
@@ -893,10 +1492,15 @@ namespace GlideJsonScheme {
       Object & operator=(const Object &input);
       Object & operator=(Object &&input);
       virtual GlideJson::Type getType() const;
-      virtual std::string toJson() const;
-      virtual std::string toJson(GlideJson::Whitespace type, size_t depth) const;
+    private:
+      static inline void encodeKey(const GlideHashMapEntry<GlideJson> &entry, GlideJsonSink &output);
+    public:
+      virtual void toJson(GlideJsonSink &output) const;
+      virtual void toJson(GlideJsonSink &output, const GlideJsonStyle &style, size_t depth) const;
       virtual const GlideHashMap<GlideJson> & theObject() const;
       virtual GlideHashMap<GlideJson> & theObject();
+      virtual void remember(bool input);
+      virtual void rememberTree(bool input);
     private:
       static GlideLfs objectCache;
     public:
@@ -910,6 +1514,7 @@ namespace GlideJsonScheme {
   class Parser {
     friend class ParserInitializer;
     private:
+      typedef GlideHashMapIterator<std::list<GlideHashMap<GlideJson>::KeyPair>::iterator> ObjectIterator;
       static unsigned char hexMap[GLIDE_BYTE_SIZE];
       static unsigned char stateMap[GLIDE_BYTE_SIZE * GLIDE_JSON_PARSER_STATES];
       static bool incompleteMap[GLIDE_JSON_PARSER_STATES];
@@ -920,9 +1525,269 @@ namespace GlideJsonScheme {
       Parser(const Parser &input);
       ~Parser();
       Parser & operator=(const Parser &input);
+      class Actions;
+      class Builder;
+      class ViewBuilder;
+      class Emitter;
+      class Recorder;
+      class Checker;
+      class Rebuilder;
+      template<class T>
+      static inline size_t scan(T &actions, const char *cInput, size_t size, unsigned char &resumeState, unsigned short &resumeUnicode);
+      static bool feed(GlideJsonParser &parser, const std::shared_ptr<const void> &owner, const char *cInput, size_t size);
+      static void truncate(GlideHashMap<GlideJson> &object, const ObjectIterator &from);
+      static GlideJsonParser & threadParser();
+      static bool split(const char *cInput, size_t size, size_t begin, size_t share, std::vector<size_t> &cuts);
     public:
+      static bool feed(GlideJsonParser &parser, const std::string &input);
+      static bool feed(GlideJsonParser &parser, const char *cInput, size_t size);
+      static GlideJson finish(GlideJsonParser &parser);
       static GlideJson parse(const std::string &input);
       static GlideJson parse(const char *cInput, size_t size);
+      static GlideJson parse(const std::shared_ptr<const void> &owner, const char *cInput, size_t size);
+      static GlideJson parse(const char *cInput, size_t size, const GlideJsonLimits &limits);
+      static GlideJson parseFile(const std::string &path);
+      static GlideJson parseFileShared(const std::string &path);
+      static GlideJson parseInParallel(const char *cInput, size_t size, size_t threads);
+      static bool next(GlideJsonArrayReader &reader, GlideJson &output);
+      static bool parseInto(GlideJson &target, const std::string &input);
+      static bool parseInto(GlideJson &target, const char *cInput, size_t size);
+      static GlideJson parse(const std::string &input, GlideJsonHandler &handler);
+      static GlideJson parse(const char *cInput, size_t size, GlideJsonHandler &handler);
+      static GlideJson parse(const char *cInput, size_t size, const GlideJsonSelector &selector);
+      static GlideJson parse(const std::string &input, GlideJsonTape &tape);
+      static GlideJson parse(const char *cInput, size_t size, GlideJsonTape &tape);
+      static bool validate(const std::string &input, size_t &index);
+      static bool validate(const char *cInput, size_t size, size_t &index);
+  };
+
+  class Parser::Actions {
+    protected:
+      unsigned char key;
+      Actions();
+      ~Actions();
+    private:
+      Actions(const Actions &input);
+      Actions & operator=(const Actions &input);
+    public:
+      inline void onNull(const char *at);
+      inline void onBoolean(bool input, const char *at);
+      inline bool onNumber(unsigned char state, const char *at);
+      inline bool onNumberByte(unsigned char state, unsigned char input);
+      inline bool onDigits(unsigned char state, const char *at, size_t size);
+      inline void onNumberEnd(const char *at);
+      inline bool onString(const char *at, const char *end);
+      inline bool onVerbatim(const char *at, size_t size);
+      inline bool onStringEnd(const char *at);
+      inline bool onEscape(const char *at);
+      inline void onDecoded(unsigned char input);
+      inline bool onMultibyte(unsigned char input);
+      inline bool onArray(const char *at);
+      inline void onEmptyArray(const char *at);
+      inline bool onArrayEnd(const char *at);
+      inline bool onComma(const char *at, unsigned char &state);
+      inline bool onObject(const char *at);
+      inline void onEmptyObject(const char *at);
+      inline bool onObjectEnd(const char *at);
+      inline bool onColon();
+  };
+
+  class Parser::Builder : public Parser::Actions {
+    protected:
+      GlideJson *cOutput;
+      std::string *decoded;
+      size_t decodedSize;
+      size_t decodedCapacity;
+      std::string &scratch;
+      GlideJson &objectKey;
+      std::vector<GlideJson *> &containers;
+      const GlideJsonLimits &limits;
+      size_t nodes;
+      size_t bytes;
+      inline bool fits(size_t run);
+      inline void settle();
+      inline bool fail(unsigned char input);
+    public:
+      unsigned char exceeded;
+      Builder(GlideJsonParser &parser);
+      ~Builder();
+      bool store(GlideJsonParser &parser, unsigned char state, unsigned short unicode, size_t finalIndex, size_t size) const;
+      inline void onNull(const char *at);
+      inline void onBoolean(bool input, const char *at);
+      inline bool onNumber(unsigned char state, const char *at);
+      inline bool onNumberByte(unsigned char state, unsigned char input);
+      inline bool onDigits(unsigned char state, const char *at, size_t size);
+      inline bool onString(const char *at, const char *end);
+      inline bool onVerbatim(const char *at, size_t size);
+      inline bool onStringEnd(const char *at);
+      inline bool onEscape(const char *at);
+      inline void onDecoded(unsigned char input);
+      inline bool onMultibyte(unsigned char input);
+      inline bool onArray(const char *at);
+      inline void onEmptyArray(const char *at);
+      inline bool onArrayEnd(const char *at);
+      inline bool onComma(const char *at, unsigned char &state);
+      inline bool onObject(const char *at);
+      inline void onEmptyObject(const char *at);
+      inline bool onObjectEnd(const char *at);
+      inline bool onColon();
+  };
+
+  class Parser::ViewBuilder : public Parser::Builder {
+    private:
+      const std::shared_ptr<const void> &owner;
+      StringView *view;
+    public:
+      ViewBuilder(GlideJsonParser &parser, const std::shared_ptr<const void> &owner);
+      ~ViewBuilder();
+      inline bool onString(const char *at, const char *end);
+      inline bool onVerbatim(const char *at, size_t size);
+      inline bool onStringEnd(const char *at);
+      inline bool onEscape(const char *at);
+      inline bool onMultibyte(unsigned char input);
+  };
+
+  class Parser::Emitter : public Parser::Actions {
+    private:
+      GlideJsonHandler &handler;
+      const char *number;
+      std::vector<unsigned char> containers;
+      size_t decodedSize;
+      size_t decodedCapacity;
+      std::string decoded;
+    public:
+      Emitter(GlideJsonHandler &handler);
+      ~Emitter();
+      bool finish(const char *end);
+      inline void onNull(const char *at);
+      inline void onBoolean(bool input, const char *at);
+      inline bool onNumber(unsigned char state, const char *at);
+      inline void onNumberEnd(const char *at);
+      inline bool onString(const char *at, const char *end);
+      inline bool onVerbatim(const char *at, size_t size);
+      inline bool onStringEnd(const char *at);
+      inline void onDecoded(unsigned char input);
+      inline bool onMultibyte(unsigned char input);
+      inline bool onArray(const char *at);
+      inline void onEmptyArray(const char *at);
+      inline bool onArrayEnd(const char *at);
+      inline bool onComma(const char *at, unsigned char &state);
+      inline bool onObject(const char *at);
+      inline void onEmptyObject(const char *at);
+      inline bool onObjectEnd(const char *at);
+  };
+
+  class Parser::Recorder : public Parser::Actions {
+    private:
+      const char *input;
+      std::vector<TapeEntry> &entries;
+      std::vector<size_t> containers;
+      size_t number;
+      bool numberPending;
+      inline void add(GlideJson::Type type, const char *at, size_t size, unsigned char flag);
+      inline void open(GlideJson::Type type, const char *at);
+      inline bool close(GlideJson::Type type, const char *at);
+    public:
+      Recorder(GlideJsonTape &tape, const char *input);
+      ~Recorder();
+      bool finish(const char *end);
+      inline void onNull(const char *at);
+      inline void onBoolean(bool input, const char *at);
+      inline bool onNumber(unsigned char state, const char *at);
+      inline void onNumberEnd(const char *at);
+      inline bool onString(const char *at, const char *end);
+      inline bool onStringEnd(const char *at);
+      inline bool onEscape(const char *at);
+      inline bool onArray(const char *at);
+      inline void onEmptyArray(const char *at);
+      inline bool onArrayEnd(const char *at);
+      inline bool onComma(const char *at, unsigned char &state);
+      inline bool onObject(const char *at);
+      inline void onEmptyObject(const char *at);
+      inline bool onObjectEnd(const char *at);
+  };
+
+  class Parser::Checker : public Parser::Actions {
+    private:
+      std::vector<bool> containers;
+    public:
+      Checker();
+      ~Checker();
+      bool finish() const;
+      inline bool onArray(const char *at);
+      inline void onEmptyArray(const char *at);
+      inline bool onArrayEnd(const char *at);
+      inline bool onComma(const char *at, unsigned char &state);
+      inline bool onObject(const char *at);
+      inline void onEmptyObject(const char *at);
+      inline bool onObjectEnd(const char *at);
+  };
+
+  class Parser::Rebuilder : public Parser::Actions {
+    private:
+      std::vector<GlideJson *> &containers;
+      std::vector<size_t> &positions;
+      std::vector<ObjectIterator> &iterators;
+      std::string &keyString;
+      GlideJson *cOutput;
+      std::string *decoded;
+      size_t decodedSize;
+      size_t decodedCapacity;
+      inline void begin(std::string &input);
+      inline void settle();
+      inline void pop();
+    public:
+      Rebuilder(GlideJson &target, std::vector<GlideJson *> &containers, std::vector<size_t> &positions, std::vector<ObjectIterator> &iterators, std::string &keyString);
+      ~Rebuilder();
+      bool finish();
+      inline void onNull(const char *at);
+      inline void onBoolean(bool input, const char *at);
+      inline bool onNumber(unsigned char state, const char *at);
+      inline bool onNumberByte(unsigned char state, unsigned char input);
+      inline bool onDigits(unsigned char state, const char *at, size_t size);
+      inline bool onString(const char *at, const char *end);
+      inline bool onVerbatim(const char *at, size_t size);
+      inline void onDecoded(unsigned char input);
+      inline bool onMultibyte(unsigned char input);
+      inline bool onArray(const char *at);
+      inline void onEmptyArray(const char *at);
+      inline bool onArrayEnd(const char *at);
+      inline bool onComma(const char *at, unsigned char &state);
+      inline bool onObject(const char *at);
+      inline void onEmptyObject(const char *at);
+      inline bool onObjectEnd(const char *at);
+      inline bool onColon();
+  };
+
+  class Selection : public GlideJsonHandler {
+    private:
+      const GlideJsonSelector &selector;
+      std::vector<GlideJson *> containers;
+      std::vector<size_t> starts;
+      std::vector<size_t> counts;
+      std::vector<size_t> nodes;
+      std::vector<size_t> candidates;
+      size_t skipped;
+      std::string key;
+      bool select();
+      GlideJson & slot();
+      void start(GlideJson::Type type);
+      void end();
+      Selection(const Selection &input);
+      Selection & operator=(const Selection &input);
+    public:
+      GlideJson output;
+      Selection(const GlideJsonSelector &selector);
+      virtual ~Selection();
+      virtual void onNull();
+      virtual void onBoolean(bool input);
+      virtual void onNumber(const char *input, size_t size);
+      virtual void onString(const char *input, size_t size);
+      virtual void onKey(const char *input, size_t size);
+      virtual void onStartArray();
+      virtual void onEndArray();
+      virtual void onStartObject();
+      virtual void onEndObject();
   };
 
   class ParserInitializer {
@@ -933,6 +1798,7 @@ namespace GlideJsonScheme {
     public:
       ~ParserInitializer();
       ParserInitializer & operator=(const ParserInitializer &input);
+      static const ParserInitializer & initializer();
   };
 
 }
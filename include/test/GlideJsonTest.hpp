@@ -25,8 +25,30 @@
 #include <ctime>
 #include <chrono>
 #include <iostream>
+#include <sstream>
 #include <random>
 #include <thread>
+#include <cstdio>
+#include <cmath>
+
+class GlideJsonTestHandler : public GlideJsonHandler {
+  private:
+    std::vector<bool> first;
+    void separate();
+  public:
+    std::string output;
+    GlideJsonTestHandler();
+    virtual ~GlideJsonTestHandler();
+    virtual void onNull();
+    virtual void onBoolean(bool input);
+    virtual void onNumber(const char *input, size_t size);
+    virtual void onString(const char *input, size_t size);
+    virtual void onKey(const char *input, size_t size);
+    virtual void onStartArray();
+    virtual void onEndArray();
+    virtual void onStartObject();
+    virtual void onEndObject();
+};
 
 class GlideJsonTest {
   private:
@@ -52,6 +74,37 @@ class GlideJsonTest {
     static void testJson();
     static void testJsonUtf8();
     static void testJsonContainers();
+    static void checkScanned(const char *input, size_t size, const std::string &expected);
+    static void testJsonScanRuns();
+    static void testJsonScanStrings();
+    static void testJsonEncodeRuns();
+    static void feedInChunks(const std::string &input, GlideJsonParser &parser);
+    static void testJsonChunks();
+    static void testJsonHandler();
+    static std::string viewToJson(const GlideJsonView &input);
+    static void compareView(const GlideJsonView &view, const GlideJson &input, const std::string &generated);
+    static void testJsonTape();
+    static std::string stringsOf(const GlideJson &input);
+    static void testJsonShared();
+    static std::string randomPath(const GlideJson &input, std::vector<std::string> &tokens);
+    static void testJsonSelector();
+    static void testJsonValidate();
+    static void testJsonLines();
+    static void testJsonParseInto();
+    static void testJsonIntegers();
+    static void testJsonDoubles();
+    static void testJsonShortestDoubles();
+    static void testJsonParseInParallel();
+    static void testJsonParseFile();
+    static void testJsonArrayReader();
+    static void measure(const GlideJson &input, size_t depth, GlideJsonLimits &output);
+    static void testJsonLimits();
+    static void testJsonToBuffer();
+    static void testJsonSink();
+    static void testJsonMeasure();
+    static void testJsonStyle();
+    static void testJsonKeyMemo();
+    static void testJsonRemember();
     static void testJsonInParallel();
     static int run();
 };
@@ -17,6 +17,10 @@
 
 #include "GlideJson.hpp"
 
+#if defined(__GNUC__) && (defined(__AVX2__) || defined(__SSE2__))
+  #include <immintrin.h>
+#endif
+
 GlideLfsNode::GlideLfsNode() : below(NULL) {
 }
 
@@ -204,6 +208,184 @@ inline void GlideString::append(const unsigned char &inputChar, size_t &inputSiz
   #pragma GCC diagnostic pop
 }
 
+inline void GlideString::append(const char *inputChars, const size_t &inputLength, size_t &inputSize, size_t &inputCapacity, std::string &input) {
+  #pragma GCC diagnostic push
+  #pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+  size_t required(inputSize + inputLength);
+  if(required > inputCapacity) {
+    nearestPower(required, inputCapacity);
+    input.resize(inputCapacity);
+  }
+  std::memcpy(&(input[inputSize]), inputChars, inputLength);
+  inputSize = required;
+  #pragma GCC diagnostic pop
+}
+
+// ========================================
+
+/*
+  The FSMs spend most of their time in states that simply loop back on
+  themselves: whitespace between elements, the digits of a number, and
+  the plain ASCII inside a string. "GlideScan" finds the end of such a
+  run 32 bytes (AVX2) or 16 bytes (SSE2) at a time, so the FSM only has
+  to visit the byte that actually changes its state. The remainder of the input that doesn't
+  fill a vector is scanned one byte at a time, which is also the
+  fallback when no vector instructions are available.
+*/
+#if defined(__GNUC__) && defined(__AVX2__)
+  #define GLIDE_SCAN_WIDTH 32
+  #define GLIDE_SCAN_FULL 0xFFFFFFFFu
+  typedef __m256i GlideScanVector;
+  #define GLIDE_SCAN_LOAD(input) _mm256_loadu_si256((const __m256i *)(input))
+  #define GLIDE_SCAN_SET(input) _mm256_set1_epi8(input)
+  #define GLIDE_SCAN_EQ(x, y) _mm256_cmpeq_epi8(x, y)
+  #define GLIDE_SCAN_OR(x, y) _mm256_or_si256(x, y)
+  #define GLIDE_SCAN_SUB(x, y) _mm256_sub_epi8(x, y)
+  #define GLIDE_SCAN_MAX(x, y) _mm256_max_epu8(x, y)
+  #define GLIDE_SCAN_GT(x, y) _mm256_cmpgt_epi8(x, y)
+  #define GLIDE_SCAN_MASK(input) ((unsigned int)(_mm256_movemask_epi8(input)))
+#elif defined(__GNUC__) && defined(__SSE2__)
+  #define GLIDE_SCAN_WIDTH 16
+  #define GLIDE_SCAN_FULL 0xFFFFu
+  typedef __m128i GlideScanVector;
+  #define GLIDE_SCAN_LOAD(input) _mm_loadu_si128((const __m128i *)(input))
+  #define GLIDE_SCAN_SET(input) _mm_set1_epi8(input)
+  #define GLIDE_SCAN_EQ(x, y) _mm_cmpeq_epi8(x, y)
+  #define GLIDE_SCAN_OR(x, y) _mm_or_si128(x, y)
+  #define GLIDE_SCAN_SUB(x, y) _mm_sub_epi8(x, y)
+  #define GLIDE_SCAN_MAX(x, y) _mm_max_epu8(x, y)
+  #define GLIDE_SCAN_GT(x, y) _mm_cmpgt_epi8(x, y)
+  #define GLIDE_SCAN_MASK(input) ((unsigned int)(_mm_movemask_epi8(input)))
+#endif
+
+inline size_t GlideScan::whitespace(const char *input, size_t index, size_t size) {
+  #ifdef GLIDE_SCAN_WIDTH
+  const GlideScanVector space(GLIDE_SCAN_SET(' '));
+  const GlideScanVector tab(GLIDE_SCAN_SET('\t'));
+  const GlideScanVector lf(GLIDE_SCAN_SET('\n'));
+  const GlideScanVector cr(GLIDE_SCAN_SET('\r'));
+  GlideScanVector chunk;
+  unsigned int mask;
+  while(index + GLIDE_SCAN_WIDTH <= size) {
+    chunk = GLIDE_SCAN_LOAD(input + index);
+    mask = GLIDE_SCAN_MASK(GLIDE_SCAN_OR(
+      GLIDE_SCAN_OR(GLIDE_SCAN_EQ(chunk, space), GLIDE_SCAN_EQ(chunk, tab)),
+      GLIDE_SCAN_OR(GLIDE_SCAN_EQ(chunk, lf), GLIDE_SCAN_EQ(chunk, cr))
+    )) ^ GLIDE_SCAN_FULL;
+    if(mask) {
+      return index + __builtin_ctz(mask);
+    }
+    index += GLIDE_SCAN_WIDTH;
+  }
+  #endif
+  while(index < size) {
+    switch(input[index]) {
+      case ' ':
+      case '\t':
+      case '\n':
+      case '\r':
+        ++index;
+        break;
+      default:
+        return index;
+    }
+  }
+  return index;
+}
+
+inline size_t GlideScan::digits(const char *input, size_t index, size_t size) {
+  #ifdef GLIDE_SCAN_WIDTH
+  // Subtracting '0' maps the digits to 0-9 and everything else above 9:
+  const GlideScanVector zero(GLIDE_SCAN_SET('0'));
+  const GlideScanVector nine(GLIDE_SCAN_SET(9));
+  GlideScanVector chunk;
+  unsigned int mask;
+  while(index + GLIDE_SCAN_WIDTH <= size) {
+    chunk = GLIDE_SCAN_SUB(GLIDE_SCAN_LOAD(input + index), zero);
+    mask = GLIDE_SCAN_MASK(GLIDE_SCAN_EQ(GLIDE_SCAN_MAX(chunk, nine), nine)) ^ GLIDE_SCAN_FULL;
+    if(mask) {
+      return index + __builtin_ctz(mask);
+    }
+    index += GLIDE_SCAN_WIDTH;
+  }
+  #endif
+  while((index < size) && ((unsigned char)(input[index] - '0') <= 9)) {
+    ++index;
+  }
+  return index;
+}
+
+/*
+  Verbatim bytes are the printable ASCII characters other than '"' and
+  '\\'. Both control characters and non-ASCII bytes are below 0x20 when
+  compared as signed bytes, so a single comparison rules them out.
+*/
+inline size_t GlideScan::verbatim(const char *input, size_t index, size_t size) {
+  #ifdef GLIDE_SCAN_WIDTH
+  const GlideScanVector quote(GLIDE_SCAN_SET('"'));
+  const GlideScanVector backslash(GLIDE_SCAN_SET('\\'));
+  const GlideScanVector space(GLIDE_SCAN_SET(' '));
+  GlideScanVector chunk;
+  unsigned int mask;
+  while(index + GLIDE_SCAN_WIDTH <= size) {
+    chunk = GLIDE_SCAN_LOAD(input + index);
+    mask = GLIDE_SCAN_MASK(GLIDE_SCAN_OR(
+      GLIDE_SCAN_OR(GLIDE_SCAN_EQ(chunk, quote), GLIDE_SCAN_EQ(chunk, backslash)),
+      GLIDE_SCAN_GT(space, chunk)
+    ));
+    if(mask) {
+      return index + __builtin_ctz(mask);
+    }
+    index += GLIDE_SCAN_WIDTH;
+  }
+  #endif
+  while((index < size) && (((signed char)(input[index]) >= ' ') & (input[index] != '"') & (input[index] != '\\'))) {
+    ++index;
+  }
+  return index;
+}
+
+/*
+  Outside of strings, the only bytes that matter to the structure are
+  '"', ',' and the brackets. Setting bit 0x20 folds '[' and ']' onto '{'
+  and '}', but also folds 0x02 onto '"' and 0x0C onto ',', which the
+  caller has to tell apart.
+*/
+inline size_t GlideScan::structural(const char *input, size_t index, size_t size) {
+  #ifdef GLIDE_SCAN_WIDTH
+  const GlideScanVector fold(GLIDE_SCAN_SET(0x20));
+  const GlideScanVector quote(GLIDE_SCAN_SET('"'));
+  const GlideScanVector comma(GLIDE_SCAN_SET(','));
+  const GlideScanVector open(GLIDE_SCAN_SET('{'));
+  const GlideScanVector close(GLIDE_SCAN_SET('}'));
+  GlideScanVector chunk;
+  unsigned int mask;
+  while(index + GLIDE_SCAN_WIDTH <= size) {
+    chunk = GLIDE_SCAN_OR(GLIDE_SCAN_LOAD(input + index), fold);
+    mask = GLIDE_SCAN_MASK(GLIDE_SCAN_OR(
+      GLIDE_SCAN_OR(GLIDE_SCAN_EQ(chunk, quote), GLIDE_SCAN_EQ(chunk, comma)),
+      GLIDE_SCAN_OR(GLIDE_SCAN_EQ(chunk, open), GLIDE_SCAN_EQ(chunk, close))
+    ));
+    if(mask) {
+      return index + __builtin_ctz(mask);
+    }
+    index += GLIDE_SCAN_WIDTH;
+  }
+  #endif
+  while(index < size) {
+    switch(input[index] | 0x20) {
+      case '"':
+      case ',':
+      case '{':
+      case '}':
+        return index;
+      default:
+        ++index;
+    }
+  }
+  return index;
+}
+
 // ========================================
 
 inline void GlideJson::initialize(GlideJson::Type input) {
@@ -276,6 +458,17 @@ GlideJson::GlideJson(unsigned long int input) {
   *((GlideJsonScheme::Number *)content) = input;
 }
 
+// JSON has no NaN or infinities, so they're null:
+GlideJson::GlideJson(double input) {
+  if(std::fabs(input) <= std::numeric_limits<double>::max()) {
+    content = GlideJsonScheme::Number::make();
+    *((GlideJsonScheme::Number *)content) = input;
+  }
+  else {
+    content = GlideJsonScheme::Null::soleNull();
+  }
+}
+
 GlideJson::GlideJson(size_t count, char input) {
   content = GlideJsonScheme::String::make();
   ((GlideJsonScheme::String *)content)->string.assign(count, input);
@@ -359,6 +552,18 @@ GlideJson & GlideJson::operator=(unsigned long int input) {
   return *this;
 }
 
+GlideJson & GlideJson::operator=(double input) {
+  content->dispose();
+  if(std::fabs(input) <= std::numeric_limits<double>::max()) {
+    content = GlideJsonScheme::Number::make();
+    *((GlideJsonScheme::Number *)content) = input;
+  }
+  else {
+    content = GlideJsonScheme::Null::soleNull();
+  }
+  return *this;
+}
+
 bool GlideJson::setNumber(const char *input, size_t size) {
   content->dispose();
   content = GlideJsonScheme::Number::make();
@@ -406,10 +611,6 @@ GlideJson & GlideJson::operator=(std::string &&input) {
   return *this;
 }
 
-std::string GlideJson::toJson(GlideJson::Whitespace type, size_t depth) const {
-  return content->toJson(type, depth);
-}
-
 GlideJson::Type GlideJson::getType() const {
   return content->getType();
 }
@@ -471,11 +672,110 @@ bool GlideJson::notObject() const {
 }
 
 std::string GlideJson::toJson() const {
-  return content->toJson();
+  std::string output;
+  toJson(output);
+  return output;
 }
 
 std::string GlideJson::toJson(GlideJson::Whitespace type) const {
-  return content->toJson(type, 0);
+  return toJson(GlideJsonStyle(type));
+}
+
+std::string GlideJson::toJson(const GlideJsonStyle &style) const {
+  std::string output;
+  toJson(output, style);
+  return output;
+}
+
+/*
+  The whole document is serialized into "output": the string is
+  stretched to its current capacity up front, grown by doubling as
+  needed, and trimmed to the encoded size once at the end. Reusing the
+  same "output" across calls therefore stops allocating as soon as it
+  has grown large enough.
+*/
+void GlideJson::toJson(std::string &output) const {
+  GlideJsonSink sink(output);
+  content->toJson(sink);
+  output.resize(sink.filled);
+}
+
+void GlideJson::toJson(std::string &output, GlideJson::Whitespace type) const {
+  toJson(output, GlideJsonStyle(type));
+}
+
+void GlideJson::toJson(std::string &output, const GlideJsonStyle &style) const {
+  GlideJsonSink sink(output);
+  content->toJson(sink, style, 0);
+  output.resize(sink.filled);
+}
+
+// Returns false if the sink failed to write any part of the output:
+bool GlideJson::toJson(GlideJsonSink &output) const {
+  content->toJson(output);
+  return output.flush();
+}
+
+bool GlideJson::toJson(GlideJsonSink &output, GlideJson::Whitespace type) const {
+  return toJson(output, GlideJsonStyle(type));
+}
+
+bool GlideJson::toJson(GlideJsonSink &output, const GlideJsonStyle &style) const {
+  content->toJson(output, style, 0);
+  return output.flush();
+}
+
+/*
+  Writes the document into "output" without allocating, and returns its
+  full length. The document is complete only if that length is at most
+  "capacity"; anything beyond "capacity" is counted but not written. No
+  null terminator is added.
+*/
+size_t GlideJson::toJson(char *output, size_t capacity) const {
+  GlideJsonSink sink(output, capacity);
+  content->toJson(sink);
+  return sink.drained + sink.filled;
+}
+
+size_t GlideJson::toJson(char *output, size_t capacity, GlideJson::Whitespace type) const {
+  return toJson(output, capacity, GlideJsonStyle(type));
+}
+
+size_t GlideJson::toJson(char *output, size_t capacity, const GlideJsonStyle &style) const {
+  GlideJsonSink sink(output, capacity);
+  content->toJson(sink, style, 0);
+  return sink.drained + sink.filled;
+}
+
+size_t GlideJson::measureJson() const {
+  return toJson(NULL, 0);
+}
+
+size_t GlideJson::measureJson(GlideJson::Whitespace type) const {
+  return toJson(NULL, 0, GlideJsonStyle(type));
+}
+
+size_t GlideJson::measureJson(const GlideJsonStyle &style) const {
+  return toJson(NULL, 0, style);
+}
+
+/*
+  Makes this array or object keep its last compact serialization, so that
+  it is copied out verbatim until the container is next reached through a
+  non-const accessor, which turns this off again. Only this container is
+  affected and not the ones inside it.
+*/
+void GlideJson::rememberJson(bool input) {
+  content->remember(input);
+}
+
+/*
+  Does the same for this container and every array and object inside it,
+  without going through the non-const accessors, so nothing it reaches is
+  turned off again. This re-arms a whole document after changing it.
+*/
+void GlideJson::rememberJsonTree(bool input) {
+  content->rememberTree(input);
 }
 
 const std::string & GlideJson::error() const {
@@ -502,6 +802,12 @@ const GlideHashMap<GlideJson> & GlideJson::object() const {
   return content->theObject();
 }
 
+/*
+  These read the text the way they always have, with std::stoi and
+  friends: up to the first byte that isn't part of an integer, and with
+  their exceptions. The overloads taking an output use the value cached
+  by the parser instead.
+*/
 int GlideJson::toInt() const {
   return std::stoi(content->theNumber());
 }
@@ -518,6 +824,80 @@ unsigned long int GlideJson::toULong() const {
   return std::stoul(content->theNumber());
 }
 
+bool GlideJson::toInt(int &output) const {
+  if(content->getType() != GlideJson::Number) {
+    output = 0;
+    return false;
+  }
+  return !((GlideJsonScheme::Number *)content)->integer(output);
+}
+
+bool GlideJson::toUInt(unsigned int &output) const {
+  if(content->getType() != GlideJson::Number) {
+    output = 0;
+    return false;
+  }
+  return !((GlideJsonScheme::Number *)content)->integer(output);
+}
+
+bool GlideJson::toLong(long int &output) const {
+  if(content->getType() != GlideJson::Number) {
+    output = 0;
+    return false;
+  }
+  return !((GlideJsonScheme::Number *)content)->integer(output);
+}
+
+bool GlideJson::toULong(unsigned long int &output) const {
+  if(content->getType() != GlideJson::Number) {
+    output = 0;
+    return false;
+  }
+  return !((GlideJsonScheme::Number *)content)->integer(output);
+}
+
+double GlideJson::toDouble() const {
+  double output;
+  if(content->getType() != GlideJson::Number) {
+    throw GlideError("GlideJson::toDouble(): This is NOT a number!");
+  }
+  const std::string &text(((GlideJsonScheme::Number *)content)->theNumber());
+  if(((GlideJsonScheme::Number *)content)->floating(output, text.data(), text.size()) == 2) {
+    throw GlideError("GlideJson::toDouble(): Out of range!");
+  }
+  return output;
+}
+
+float GlideJson::toFloat() const {
+  float output;
+  if(content->getType() != GlideJson::Number) {
+    throw GlideError("GlideJson::toFloat(): This is NOT a number!");
+  }
+  const std::string &text(((GlideJsonScheme::Number *)content)->theNumber());
+  if(((GlideJsonScheme::Number *)content)->floating(output, text.data(), text.size()) == 2) {
+    throw GlideError("GlideJson::toFloat(): Out of range!");
+  }
+  return output;
+}
+
+bool GlideJson::toDouble(double &output) const {
+  if(content->getType() != GlideJson::Number) {
+    output = 0;
+    return false;
+  }
+  const std::string &text(((GlideJsonScheme::Number *)content)->theNumber());
+  return !((GlideJsonScheme::Number *)content)->floating(output, text.data(), text.size());
+}
+
+bool GlideJson::toFloat(float &output) const {
+  if(content->getType() != GlideJson::Number) {
+    output = 0;
+    return false;
+  }
+  const std::string &text(((GlideJsonScheme::Number *)content)->theNumber());
+  return !((GlideJsonScheme::Number *)content)->floating(output, text.data(), text.size());
+}
+
 bool & GlideJson::boolean() {
   return content->theBoolean();
 }
@@ -549,6 +929,80 @@ GlideJson GlideJson::parse(const char *input, size_t size) {
   return GlideJsonScheme::Parser::parse(input, size);
 }
 
+GlideJson GlideJson::parse(const std::string &input, const GlideJsonLimits &limits) {
+  return GlideJsonScheme::Parser::parse(input.data(), input.size(), limits);
+}
+
+GlideJson GlideJson::parse(const char *input, size_t size, const GlideJsonLimits &limits) {
+  return GlideJsonScheme::Parser::parse(input, size, limits);
+}
+
+GlideJson GlideJson::parse(const std::string &input, const GlideJsonSelector &selector) {
+  return GlideJsonScheme::Parser::parse(input.data(), input.size(), selector);
+}
+
+GlideJson GlideJson::parse(const char *input, size_t size, const GlideJsonSelector &selector) {
+  return GlideJsonScheme::Parser::parse(input, size, selector);
+}
+
+GlideJson GlideJson::parseShared(const std::shared_ptr<const std::string> &input) {
+  return GlideJsonScheme::Parser::parse(input, input->data(), input->size());
+}
+
+GlideJson GlideJson::parseShared(std::string &&input) {
+  return GlideJson::parseShared(std::make_shared<const std::string>(std::move(input)));
+}
+
+GlideJson GlideJson::parseFile(const std::string &path) {
+  return GlideJsonScheme::Parser::parseFile(path);
+}
+
+GlideJson GlideJson::parseFileShared(const std::string &path) {
+  return GlideJsonScheme::Parser::parseFileShared(path);
+}
+
+GlideJson GlideJson::parseInParallel(const std::string &input, size_t threads) {
+  return GlideJsonScheme::Parser::parseInParallel(input.data(), input.size(), threads);
+}
+
+GlideJson GlideJson::parseInParallel(const char *input, size_t size, size_t threads) {
+  return GlideJsonScheme::Parser::parseInParallel(input, size, threads);
+}
+
+bool GlideJson::parseInto(GlideJson &target, const std::string &input) {
+  return GlideJsonScheme::Parser::parseInto(target, input);
+}
+
+bool GlideJson::parseInto(GlideJson &target, const char *input, size_t size) {
+  return GlideJsonScheme::Parser::parseInto(target, input, size);
+}
+
+bool GlideJson::validate(const std::string &input) {
+  size_t index;
+  return GlideJsonScheme::Parser::validate(input, index);
+}
+
+bool GlideJson::validate(const char *input, size_t size) {
+  size_t index;
+  return GlideJsonScheme::Parser::validate(input, size, index);
+}
+
+bool GlideJson::validate(const std::string &input, size_t &index) {
+  return GlideJsonScheme::Parser::validate(input, index);
+}
+
+bool GlideJson::validate(const char *input, size_t size, size_t &index) {
+  return GlideJsonScheme::Parser::validate(input, size, index);
+}
+
+GlideJson GlideJson::parse(const std::string &input, GlideJsonHandler &handler) {
+  return GlideJsonScheme::Parser::parse(input, handler);
+}
+
+GlideJson GlideJson::parse(const char *input, size_t size, GlideJsonHandler &handler) {
+  return GlideJsonScheme::Parser::parse(input, size, handler);
+}
+
 std::string GlideJson::encodeString(const std::string &input) {
   return GlideJsonScheme::Encoder::encode(input);
 }
@@ -575,930 +1029,1036 @@ std::string GlideJson::base64Decode(const char *input, size_t size) {
 
 // ========================================
 
-namespace GlideJsonScheme {
-
-  unsigned char Encoder::hexMap[] = {0};
-  unsigned char Encoder::stateMap[GLIDE_BYTE_SIZE * GLIDE_JSON_ENCODER_STATES] = {0};
-  unsigned char Encoder::b64eMap[] = {0};
-  unsigned char Encoder::b64dMap[GLIDE_BYTE_SIZE] = {0};
+GlideHashMapEntry<GlideJson>::GlideHashMapEntry(GlideSortItem<std::string> &&key, const GlideItem<GlideJson> &value) : std::pair< GlideSortItem<std::string>, GlideItem<GlideJson> >(std::move(key), value), memoized(0), memo() {
+}
 
-  void Encoder::setEscapable(size_t state) {
-    // Control characters:
-    unsigned char i(0);
-    do {
-      stateMap[i + GLIDE_BYTE_SIZE * state] = 1;
-    }
-    while(++i <= 31);
-    // Special characters escaped with a backslash:
-    stateMap['"' + GLIDE_BYTE_SIZE * state] = 2;
-    stateMap['\\' + GLIDE_BYTE_SIZE * state] = 3;
-    stateMap['\b' + GLIDE_BYTE_SIZE * state] = 4;
-    stateMap['\f' + GLIDE_BYTE_SIZE * state] = 5;
-    stateMap['\n' + GLIDE_BYTE_SIZE * state] = 6;
-    stateMap['\r' + GLIDE_BYTE_SIZE * state] = 7;
-    stateMap['\t' + GLIDE_BYTE_SIZE * state] = 8;
+GlideHashMapEntry<GlideJson>::GlideHashMapEntry(const GlideHashMapEntry<GlideJson> &input) : std::pair< GlideSortItem<std::string>, GlideItem<GlideJson> >(input), memoized(0), memo() {
+  if(input.memoized.load() == 2) {
+    memo = input.memo;
+    memoized.store(2);
   }
+}
 
-  void Encoder::copyTransitions(size_t from, size_t to) {
-    size_t i(0);
-    do {
-      stateMap[i + GLIDE_BYTE_SIZE * to] = stateMap[i + GLIDE_BYTE_SIZE * from];
-    }
-    while(++i <= 255);
+GlideHashMapEntry<GlideJson>::~GlideHashMapEntry() {
+}
+
+GlideHashMapEntry<GlideJson> & GlideHashMapEntry<GlideJson>::operator=(const GlideHashMapEntry<GlideJson> &input) {
+  std::pair< GlideSortItem<std::string>, GlideItem<GlideJson> >::operator=(input);
+  if(input.memoized.load() == 2) {
+    memo = input.memo;
+    memoized.store(2);
+  }
+  else {
+    memo.clear();
+    memoized.store(0);
   }
+  return *this;
+}
 
-  /*
-    This "Encoder" is a FSM guided by a state map. The state map is always
-    the width of an unsigned char multiplied by the number of states.
-    Every character from an input string is mapped to a state. The
-    conversion of strings to JSON strings is binary-safe, so this FSM has
-    no failure states. Literally any combination of bytes leads to a valid
-    UTF-8 JSON string.
+// ========================================
 
-    Grammar for UTF-8 from RFC 3629:
+GlideJsonLimits::GlideJsonLimits() : depth(-1), length(-1), nodes(-1), bytes(-1) {
+}
 
-    UTF8-octets = *( UTF8-char )
-    UTF8-char   = UTF8-1 / UTF8-2 / UTF8-3 / UTF8-4
-    UTF8-1      = %x00-7F
-    UTF8-2      = %xC2-DF UTF8-tail
-    UTF8-3      = %xE0 %xA0-BF UTF8-tail /
-                  %xE1-EC 2( UTF8-tail ) /
-                  %xED %x80-9F UTF8-tail /
-                  %xEE-EF 2( UTF8-tail )
-    UTF8-4      = %xF0 %x90-BF 2( UTF8-tail ) /
-                  %xF1-F3 3( UTF8-tail ) /
-                  %xF4 %x80-8F 2( UTF8-tail )
-    UTF8-tail   = %x80-BF
+// ========================================
+
+// A scratch buffer any larger than this is given back once a parse ends:
+#define GLIDE_JSON_SCRATCH_RETAINED ((size_t)1 << 20)
+
+GlideJsonParser::GlideJsonParser() : state(1), unicode(0), offset(0), finalIndex(0), output(), cOutput(&output), decoded(NULL), decodedSize(0), decodedCapacity(GlideString::initialCapacity), scratch(decodedCapacity, '\0'), objectKey(), containers(1, &objectKey), limits(), nodes(0), bytes(0), exceeded(0) {
+}
+
+GlideJsonParser::GlideJsonParser(const GlideJsonLimits &limits) : GlideJsonParser() {
+  this->limits = limits;
+}
+
+GlideJsonParser::GlideJsonParser(const GlideJsonParser &input) {
+  (void)input;
+  throw GlideError("GlideJsonParser::GlideJsonParser(const GlideJsonParser &input): No copy constructor!");
+}
+
+GlideJsonParser::~GlideJsonParser() {
+}
+
+GlideJsonParser & GlideJsonParser::operator=(const GlideJsonParser &input) {
+  (void)input;
+  throw GlideError("GlideJsonParser::operator=(const GlideJsonParser &input): No assignment operator!");
+  return *this;
+}
+
+void GlideJsonParser::reset() {
+  state = 1;
+  unicode = 0;
+  offset = 0;
+  finalIndex = 0;
+  output = GlideJson::Null;
+  cOutput = &output;
+  decoded = NULL;
+  decodedSize = 0;
+  /*
+    The scratch buffer and the container stack keep their capacity, unless
+    a single huge value made the buffer larger than is worth keeping:
   */
-  void Encoder::initialize() {
-    // Map integers to hex characters:
-    unsigned char i(0);
-    do {
-      hexMap[i] = i + 48;
-    }
-    while(++i <= 9);
-    i = 10;
-    do {
-      hexMap[i] = i + 87;
-    }
-    while(++i <= 15);
-    // Escapable at state 0:
-    Encoder::setEscapable(0);
-    // Non-ASCII characters:
-    i = 128;
-    do {
-      stateMap[i] = 9;
-    }
-    while(++i <= 193);
-    i = 255;
-    do {
-      stateMap[i] = 9;
-    }
-    while(--i >= 245);
-    // UTF-8 pair:
-    i = 194;
-    do {
-      stateMap[i] = 10;
-    }
-    while(++i <= 223);
-    // UTF-8 triple:
-    stateMap[224] = 12;
-    i = 160;
-    do {
-      stateMap[i + GLIDE_BYTE_SIZE * 12] = 15;
-    }
-    while(++i <= 191);
-    i = 225;
-    do {
-      stateMap[i] = 13;
-    }
-    while(++i <= 236);
-    stateMap[238] = 13;
-    stateMap[239] = 13;
-    stateMap[237] = 14;
-    i = 128;
-    do {
-      stateMap[i + GLIDE_BYTE_SIZE * 14] = 15;
-    }
-    while(++i <= 159);
-    // UTF-8 quad:
-    stateMap[240] = 17;
-    i = 144;
-    do {
-      stateMap[i + GLIDE_BYTE_SIZE * 17] = 20;
-    }
-    while(++i <= 191);
-    stateMap[241] = 18;
-    stateMap[242] = 18;
-    stateMap[243] = 18;
-    stateMap[244] = 19;
-    i = 128;
-    do {
-      stateMap[i + GLIDE_BYTE_SIZE * 19] = 20;
-    }
-    while(++i <= 143);
-    // Trailing UTF-8 bytes:
-    i = 128;
-    do {
-      stateMap[i + GLIDE_BYTE_SIZE * 10] = 11;
-      stateMap[i + GLIDE_BYTE_SIZE * 13] = 15;
-      stateMap[i + GLIDE_BYTE_SIZE * 15] = 16;
-      stateMap[i + GLIDE_BYTE_SIZE * 18] = 20;
-      stateMap[i + GLIDE_BYTE_SIZE * 20] = 21;
-      stateMap[i + GLIDE_BYTE_SIZE * 21] = 22;
-    }
-    while(++i <= 191);
-    // Invalid UTF-8 triple:
-    Encoder::setEscapable(12);
-    i = 128;
-    do {
-      stateMap[i + GLIDE_BYTE_SIZE * 12] = 9;
-    }
-    while(++i <= 159);
-    i = 255;
-    do {
-      stateMap[i + GLIDE_BYTE_SIZE * 12] = 9;
-    }
-    while(--i >= 192);
-    Encoder::setEscapable(14);
-    i = 255;
-    do {
-      stateMap[i + GLIDE_BYTE_SIZE * 14] = 9;
-    }
-    while(--i >= 160);
-    // Invalid UTF-8 quad:
-    Encoder::setEscapable(17);
-    i = 128;
-    do {
-      stateMap[i + GLIDE_BYTE_SIZE * 17] = 9;
-    }
-    while(++i <= 143);
-    i = 255;
-    do {
-      stateMap[i + GLIDE_BYTE_SIZE * 17] = 9;
-    }
-    while(--i >= 192);
-    Encoder::setEscapable(19);
-    i = 255;
-    do {
-      stateMap[i + GLIDE_BYTE_SIZE * 19] = 9;
-    }
-    while(--i >= 144);
-    // Invalid trailing UTF-8 bytes:
-    Encoder::setEscapable(10);
-    Encoder::setEscapable(13);
-    Encoder::setEscapable(15);
-    Encoder::setEscapable(18);
-    Encoder::setEscapable(20);
-    Encoder::setEscapable(21);
-    i = 255;
-    do {
-      stateMap[i + GLIDE_BYTE_SIZE * 10] = 9;
-      stateMap[i + GLIDE_BYTE_SIZE * 13] = 9;
-      stateMap[i + GLIDE_BYTE_SIZE * 15] = 9;
-      stateMap[i + GLIDE_BYTE_SIZE * 18] = 9;
-      stateMap[i + GLIDE_BYTE_SIZE * 20] = 9;
-      stateMap[i + GLIDE_BYTE_SIZE * 21] = 9;
-    }
-    while(--i >= 192);
-    /*
-      All the following states need to behave exactly the same as state
-      0. They all terminate handlers of special characters, so they need to
-      behave as though the FSM is at state 0 again.
-    */
-    Encoder::copyTransitions(0, 1);
-    Encoder::copyTransitions(0, 2);
-    Encoder::copyTransitions(0, 3);
-    Encoder::copyTransitions(0, 4);
-    Encoder::copyTransitions(0, 5);
-    Encoder::copyTransitions(0, 6);
-    Encoder::copyTransitions(0, 7);
-    Encoder::copyTransitions(0, 8);
-    Encoder::copyTransitions(0, 9);
-    Encoder::copyTransitions(0, 11);
-    Encoder::copyTransitions(0, 16);
-    Encoder::copyTransitions(0, 22);
-    // Base64 encoding map:
-    i = 0;
-    do {
-      b64eMap[i] = i + 65;
-      b64dMap[i + 65] = i;
-    }
-    while(++i < 26);
-    i = 26;
-    do {
-      b64eMap[i] = i + 71;
-      b64dMap[i + 71] = i;
-    }
-    while(++i < 52);
-    i = 52;
-    do {
-      b64eMap[i] = i - 4;
-      b64dMap[i - 4] = i;
-    }
-    while(++i < 62);
-    b64eMap[62] = '+';
-    b64dMap['+'] = 62;
-    b64eMap[63] = '/';
-    b64dMap['/'] = 63;
-  }
+  if(scratch.size() > GLIDE_JSON_SCRATCH_RETAINED) {
+    std::string(GlideString::initialCapacity, '\0').swap(scratch);
+  }
+  decodedCapacity = scratch.size();
+  objectKey = GlideJson::Null;
+  containers.assign(1, &objectKey);
+  // The limits stay:
+  nodes = 0;
+  bytes = 0;
+  exceeded = 0;
+}
 
-  Encoder::Encoder() {
-    throw GlideError("GlideJsonScheme::Encoder::Encoder(): No default constructor!");
-  }
+void GlideJsonParser::setLimits(const GlideJsonLimits &limits) {
+  this->limits = limits;
+}
 
-  Encoder::Encoder(const Encoder &input) {
-    (void)input;
-    throw GlideError("GlideJsonScheme::Encoder::Encoder(const Encoder &input): No copy constructor!");
-  }
+bool GlideJsonParser::feed(const std::string &input) {
+  return GlideJsonScheme::Parser::feed(*this, input);
+}
 
-  Encoder::~Encoder() {
-  }
+bool GlideJsonParser::feed(const char *input, size_t size) {
+  return GlideJsonScheme::Parser::feed(*this, input, size);
+}
 
-  Encoder & Encoder::operator=(const Encoder &input) {
-    (void)input;
-    throw GlideError("GlideJsonScheme::Encoder::operator=(const Encoder &input): No assignment operator!");
-    return *this;
-  }
+GlideJson GlideJsonParser::finish() {
+  return GlideJsonScheme::Parser::finish(*this);
+}
 
-  /*
-    See the source file for comments:
-  */
-  #define GLIDE_JSON_PART_STDSTRING
-  #include "Encoder.inc"
-  #undef GLIDE_JSON_PART_STDSTRING
+GlideJson GlideJsonParser::parse(const std::string &input) {
+  reset();
+  GlideJsonScheme::Parser::feed(*this, input);
+  return GlideJsonScheme::Parser::finish(*this);
+}
 
-  #define GLIDE_JSON_PART_CSTRING
-  #include "Encoder.inc"
-  #undef GLIDE_JSON_PART_CSTRING
+GlideJson GlideJsonParser::parse(const char *input, size_t size) {
+  reset();
+  GlideJsonScheme::Parser::feed(*this, input, size);
+  return GlideJsonScheme::Parser::finish(*this);
+}
 
-  // ========================================
+// ========================================
 
-  EncoderInitializer::EncoderInitializer() {
-    Encoder::initialize();
-  }
+GlideJsonHandler::GlideJsonHandler() {
+}
 
-  EncoderInitializer::EncoderInitializer(const EncoderInitializer &input) {
-    (void)input;
-    throw GlideError("GlideJsonScheme::EncoderInitializer::EncoderInitializer(const EncoderInitializer &input): No copy constructor!");
-  }
+GlideJsonHandler::~GlideJsonHandler() {
+}
 
-  EncoderInitializer::~EncoderInitializer() {
-  }
+void GlideJsonHandler::onNull() {
+}
 
-  EncoderInitializer & EncoderInitializer::operator=(const EncoderInitializer &input) {
-    (void)input;
-    throw GlideError("GlideJsonScheme::EncoderInitializer::operator=(const EncoderInitializer &input): No assignment operator!");
-    return *this;
-  }
+void GlideJsonHandler::onBoolean(bool input) {
+  (void)input;
+}
 
-  const EncoderInitializer & EncoderInitializer::initializer() {
-    static const EncoderInitializer initializer;
-    return initializer;
-  }
+void GlideJsonHandler::onNumber(const char *input, size_t size) {
+  (void)input;
+  (void)size;
+}
 
-  // ========================================
+void GlideJsonHandler::onString(const char *input, size_t size) {
+  (void)input;
+  (void)size;
+}
 
-  Base::Base() : GlideLfsNode() {
-  }
+void GlideJsonHandler::onKey(const char *input, size_t size) {
+  (void)input;
+  (void)size;
+}
 
-  Base::Base(const Base &input) : GlideLfsNode() {
-    (void)input;
-  }
+void GlideJsonHandler::onStartArray() {
+}
 
-  Base::~Base() {
-  }
+void GlideJsonHandler::onEndArray() {
+}
 
-  Base & Base::operator=(const Base &input) {
-    (void)input;
-    return *this;
-  }
+void GlideJsonHandler::onStartObject() {
+}
 
-  GlideJson::Type Base::getType() const {
-    throw GlideError("GlideJsonScheme::Base::getType(): This is an abstract class!");
-    return GlideJson::Null;
-  }
+void GlideJsonHandler::onEndObject() {
+}
 
-  std::string Base::toJson() const {
-    throw GlideError("GlideJsonScheme::Base::toJson(): This is an abstract class!");
-    return std::string();
-  }
+// ========================================
 
-  std::string Base::toJson(GlideJson::Whitespace type, size_t depth) const {
-    (void)type;
-    (void)depth;
-    throw GlideError("GlideJsonScheme::Base::toJson(GlideJson::Whitespace type, size_t depth): This is an abstract class!");
-    return std::string();
-  }
+/*
+  Records are separated by '\n', and a '\r' right before it is dropped so
+  that errors refer to the record itself. Every line is a record,
+  including an empty one, so the position of a result is always its line
+  number (counting from 0). The only exception is the empty line after a
+  final '\n'.
 
-  const std::string & Base::theError() const {
-    static const std::string nothing;
-    throw GlideError("GlideJsonScheme::Base::theError(): This is NOT a GlideJsonScheme::Error object!");
-    return nothing;
-  }
+  Callbacks are always invoked in order and on the calling thread. The
+  input is parsed in batches of about GLIDE_JSON_LINES_BATCH bytes so
+  that only one batch of results is held at a time.
+*/
+#define GLIDE_JSON_LINES_BATCH ((size_t)1 << 24)
+#define GLIDE_JSON_LINES_GROUP 64
 
-  const bool & Base::theBoolean() const {
-    static const bool nothing(false);
-    throw GlideError("GlideJsonScheme::Base::theBoolean(): This is NOT a GlideJsonScheme::Boolean object!");
-    return nothing;
+GlideJsonLines::GlideJsonLines() : threads(std::thread::hardware_concurrency()) {
+  if(!threads) {
+    threads = 1;
   }
+}
 
-  bool & Base::theBoolean() {
-    static bool nothing(false);
-    throw GlideError("GlideJsonScheme::Base::theBoolean(): This is NOT a GlideJsonScheme::Boolean object!");
-    return nothing;
-  }
+GlideJsonLines::GlideJsonLines(size_t threads) : threads(threads ? threads : 1) {
+}
 
-  const std::string & Base::theNumber() const {
-    static const std::string nothing;
-    throw GlideError("GlideJsonScheme::Base::theNumber(): This is NOT a GlideJsonScheme::Number object!");
-    return nothing;
-  }
+GlideJsonLines::GlideJsonLines(const GlideJsonLines &input) : threads(input.threads) {
+}
 
-  const std::string & Base::theString() const {
-    static const std::string nothing;
-    throw GlideError("GlideJsonScheme::Base::theString(): This is NOT a GlideJsonScheme::String object!");
-    return nothing;
-  }
+GlideJsonLines::~GlideJsonLines() {
+}
 
-  std::string & Base::theString() {
-    static std::string nothing;
-    throw GlideError("GlideJsonScheme::Base::theString(): This is NOT a GlideJsonScheme::String object!");
-    return nothing;
-  }
+GlideJsonLines & GlideJsonLines::operator=(const GlideJsonLines &input) {
+  threads = input.threads;
+  return *this;
+}
 
-  const std::vector<GlideJson> & Base::theArray() const {
-    static const std::vector<GlideJson> nothing;
-    throw GlideError("GlideJsonScheme::Base::theArray(): This is NOT a GlideJsonScheme::Array object!");
-    return nothing;
+// Record "i" starts at "lines[i]" and ends right before "lines[i + 1] - 1":
+void GlideJsonLines::split(const char *input, size_t size, std::vector<size_t> &lines) {
+  const char *current(input);
+  const char *end(input + size);
+  lines.assign(1, 0);
+  while((current = (const char *)std::memchr(current, '\n', end - current))) {
+    ++current;
+    lines.push_back(current - input);
+  }
+  if(lines.back() < size) {
+    lines.push_back(size + 1);
   }
+}
 
-  std::vector<GlideJson> & Base::theArray() {
-    static std::vector<GlideJson> nothing;
-    throw GlideError("GlideJsonScheme::Base::theArray(): This is NOT a GlideJsonScheme::Array object!");
-    return nothing;
-  }
+/*
+  Workers claim groups of records through "next" rather than fixed
+  shares, since the records can vary wildly in size. The calling thread
+  is one of the workers.
+*/
+void GlideJsonLines::parseBatch(const char *input, const std::vector<size_t> &lines, std::vector<GlideJson> &output) const {
+  size_t records(lines.size() - 1);
+  output.resize(records);
+  std::atomic<size_t> next(0);
+  auto work([&]() {
+    size_t i;
+    size_t end;
+    size_t size;
+    while((i = next.fetch_add(GLIDE_JSON_LINES_GROUP)) < records) {
+      end = std::min(i + GLIDE_JSON_LINES_GROUP, records);
+      while(i < end) {
+        size = lines[i + 1] - 1 - lines[i];
+        if(size && (input[lines[i] + size - 1] == '\r')) {
+          --size;
+        }
+        output[i] = GlideJson::parse(input + lines[i], size);
+        ++i;
+      }
+    }
+  });
+  size_t workers(std::min(threads, (records + GLIDE_JSON_LINES_GROUP - 1) / GLIDE_JSON_LINES_GROUP));
+  // Whichever threads do start share the work with this one:
+  GlideJsonScheme::Workers pool(workers ? (workers - 1) : 0, work);
+  work();
+  pool.join();
+}
 
-  const GlideHashMap<GlideJson> & Base::theObject() const {
-    static const GlideHashMap<GlideJson> nothing;
-    throw GlideError("GlideJsonScheme::Base::theObject(): This is NOT a GlideJsonScheme::Object object!");
-    return nothing;
+size_t GlideJsonLines::parse(const char *input, size_t size, size_t line, const std::function<void(size_t, GlideJson &)> &callback) const {
+  std::vector<size_t> lines;
+  std::vector<GlideJson> output;
+  size_t first(line);
+  size_t offset(0);
+  size_t cut;
+  size_t i;
+  while(offset < size) {
+    cut = size;
+    if(size - offset > GLIDE_JSON_LINES_BATCH) {
+      const char *found((const char *)std::memchr(input + offset + GLIDE_JSON_LINES_BATCH, '\n', size - offset - GLIDE_JSON_LINES_BATCH));
+      if(found) {
+        cut = found - input + 1;
+      }
+    }
+    GlideJsonLines::split(input + offset, cut - offset, lines);
+    parseBatch(input + offset, lines, output);
+    i = 0;
+    while(i < output.size()) {
+      callback(line, output[i]);
+      ++line;
+      ++i;
+    }
+    offset = cut;
   }
+  return line - first;
+}
 
-  GlideHashMap<GlideJson> & Base::theObject() {
-    static GlideHashMap<GlideJson> nothing;
-    throw GlideError("GlideJsonScheme::Base::theObject(): This is NOT a GlideJsonScheme::Object object!");
-    return nothing;
-  }
+std::vector<GlideJson> GlideJsonLines::parse(const std::string &input) const {
+  return parse(input.data(), input.size());
+}
 
-  void Base::dispose() {
-    throw GlideError("GlideJsonScheme::Base::dispose(void *input): This is an abstract class!");
-  }
+std::vector<GlideJson> GlideJsonLines::parse(const char *input, size_t size) const {
+  std::vector<size_t> lines;
+  std::vector<GlideJson> output;
+  GlideJsonLines::split(input, size, lines);
+  parseBatch(input, lines, output);
+  return output;
+}
 
-  Base * Base::duplicate() const {
-    throw GlideError("GlideJsonScheme::Base::duplicate(Base * &location): This is an abstract class!");
-  }
+void GlideJsonLines::parse(const std::string &input, const std::function<void(size_t, GlideJson &)> &callback) const {
+  parse(input.data(), input.size(), 0, callback);
+}
 
-  // ========================================
+void GlideJsonLines::parse(const char *input, size_t size, const std::function<void(size_t, GlideJson &)> &callback) const {
+  parse(input, size, 0, callback);
+}
 
-  Error::Error() : Base(), error() {
+/*
+  The file is read one batch at a time. Whatever follows the last '\n' of
+  a batch is carried over to the next one. Returns false if the file
+  can't be opened or read.
+*/
+bool GlideJsonLines::parseFile(const std::string &path, const std::function<void(size_t, GlideJson &)> &callback) const {
+  std::ifstream file(path, std::ios::binary);
+  if(!file) {
+    return false;
+  }
+  std::string buffer;
+  size_t carried;
+  size_t cut;
+  size_t line(0);
+  while(file) {
+    carried = buffer.size();
+    buffer.resize(carried + GLIDE_JSON_LINES_BATCH);
+    file.read(&(buffer[carried]), GLIDE_JSON_LINES_BATCH);
+    buffer.resize(carried + file.gcount());
+    if(file) {
+      cut = buffer.rfind('\n');
+      if(cut != std::string::npos) {
+        line += parse(buffer.data(), cut + 1, line, callback);
+        buffer.erase(0, cut + 1);
+      }
+    }
   }
-
-  Error::Error(const std::string &input) : Base(), error(input) {
+  if(file.bad()) {
+    return false;
   }
+  parse(buffer.data(), buffer.size(), line, callback);
+  return true;
+}
 
-  Error::Error(const Error &input) : Base(), error(input.error) {
-  }
+#undef GLIDE_JSON_LINES_GROUP
+#undef GLIDE_JSON_LINES_BATCH
 
-  Error::Error(Error &&input) : Base(), error(std::move(input.error)) {
-  }
+// ========================================
 
-  Error::~Error() {
-  }
+/*
+  The input is read "capacity" bytes at a time into the same buffer, and
+  only the element being parsed is ever held beyond it. "offset" is the
+  index of the buffer's first byte within the whole input.
+*/
+#define GLIDE_JSON_READER_CAPACITY ((size_t)1 << 16)
 
-  Error & Error::operator=(const Error &input) {
-    error = input.error;
-    return *this;
-  }
+GlideJsonArrayReader::GlideJsonArrayReader(std::istream &stream) : GlideJsonArrayReader(stream, GLIDE_JSON_READER_CAPACITY) {
+}
 
-  Error & Error::operator=(Error &&input) {
-    error = std::move(input.error);
-    return *this;
-  }
+GlideJsonArrayReader::GlideJsonArrayReader(std::istream &stream, size_t capacity) : descriptor(-1), stream(&stream), buffer(capacity ? capacity : 1, '\0'), filled(0), position(0), offset(0), depth(0), stage(GlideJsonArrayReader::Opening), quoted(false), escaped(false), unreadable(false), parser() {
+}
 
-  GlideJson::Type Error::getType() const {
-    return GlideJson::Error;
-  }
+#ifdef GLIDE_JSON_POSIX
+GlideJsonArrayReader::GlideJsonArrayReader(int descriptor) : GlideJsonArrayReader(descriptor, GLIDE_JSON_READER_CAPACITY) {
+}
 
-  std::string Error::toJson() const {
-    return Encoder::encode(error);
-  }
+GlideJsonArrayReader::GlideJsonArrayReader(int descriptor, size_t capacity) : descriptor(descriptor), stream(NULL), buffer(capacity ? capacity : 1, '\0'), filled(0), position(0), offset(0), depth(0), stage(GlideJsonArrayReader::Opening), quoted(false), escaped(false), unreadable(false), parser() {
+}
+#endif
 
-  std::string Error::toJson(GlideJson::Whitespace type, size_t depth) const {
-    (void)type;
-    (void)depth;
-    return Encoder::encode(error);
-  }
+GlideJsonArrayReader::GlideJsonArrayReader(const GlideJsonArrayReader &input) {
+  (void)input;
+  throw GlideError("GlideJsonArrayReader::GlideJsonArrayReader(const GlideJsonArrayReader &input): No copy constructor!");
+}
 
-  const std::string & Error::theError() const {
-    return error;
-  }
+GlideJsonArrayReader::~GlideJsonArrayReader() {
+}
 
-  GlideLfs Error::errorCache;
+GlideJsonArrayReader & GlideJsonArrayReader::operator=(const GlideJsonArrayReader &input) {
+  (void)input;
+  throw GlideError("GlideJsonArrayReader::operator=(const GlideJsonArrayReader &input): No assignment operator!");
+  return *this;
+}
 
-  Error * Error::make() {
-    Error *output((Error *)(errorCache.pop()));
-    if(output == NULL) {
-      output = new Error();
+// Returns false at the end of the input, and also sets "unreadable" if reading failed:
+bool GlideJsonArrayReader::fill() {
+  offset += filled;
+  filled = 0;
+  position = 0;
+  if(stream) {
+    stream->read(&(buffer[0]), buffer.size());
+    filled = stream->gcount();
+    unreadable = stream->bad();
+  }
+  #ifdef GLIDE_JSON_POSIX
+  else {
+    ssize_t count;
+    do {
+      count = ::read(descriptor, &(buffer[0]), buffer.size());
+    }
+    while((count < 0) && (errno == EINTR));
+    if(count < 0) {
+      unreadable = true;
+    }
+    else {
+      filled = count;
     }
-    return output;
   }
+  #endif
+  return filled > 0;
+}
 
-  void Error::dispose() {
-    error.clear();
-    errorCache.push(this);
-  }
+/*
+  Returns true with the next element in "output", or with an error if the
+  input turned out to be anything but an array. Returns false once the
+  array is closed and nothing but whitespace follows it.
+*/
+bool GlideJsonArrayReader::next(GlideJson &output) {
+  return GlideJsonScheme::Parser::next(*this, output);
+}
 
-  Error * Error::duplicate() const {
-    Error *output((Error *)(errorCache.pop()));
-    if(output == NULL) {
-      output = new Error();
-    }
-    output->error = error;
-    return output;
-  }
+#undef GLIDE_JSON_READER_CAPACITY
 
-  // ========================================
+// ========================================
 
-  Null::Null() : Base() {
-  }
+/*
+  Output is collected "capacity" bytes at a time and handed to the
+  stream, callback, or file descriptor whenever that much is ready, so
+  serializing a document of any size takes a constant amount of memory.
+  The private constructors instead write straight into a string that
+  grows, or into the caller's memory that doesn't. Once the latter is
+  full, its capacity drops to 0 and the rest of the output is only
+  counted, never copied.
+*/
+#define GLIDE_JSON_SINK_CAPACITY ((size_t)1 << 16)
+
+GlideJsonSink::GlideJsonSink(std::string &target) : descriptor(-1), stream(NULL), callback(), target(&target), buffer(), data(NULL), filled(0), capacity(target.capacity()), drained(0), bounded(false), failed(false) {
+  if(capacity < GlideString::initialCapacity) {
+    capacity = GlideString::initialCapacity;
+  }
+  target.resize(capacity);
+  data = &(target[0]);
+}
 
-  Null::Null(const Null &input) : Base() {
-    (void)input;
+GlideJsonSink::GlideJsonSink(char *memory, size_t capacity) : descriptor(-1), stream(NULL), callback(), target(NULL), buffer(), data(memory), filled(0), capacity(capacity), drained(0), bounded(true), failed(false) {
+  if(!memory || !capacity) {
+    drain();
   }
+}
 
-  Null::~Null() {
-  }
+GlideJsonSink::GlideJsonSink(std::ostream &stream) : GlideJsonSink(stream, GLIDE_JSON_SINK_CAPACITY) {
+}
 
-  Null & Null::operator=(const Null &input) {
-    (void)input;
-    return *this;
-  }
+GlideJsonSink::GlideJsonSink(std::ostream &stream, size_t capacity) : descriptor(-1), stream(&stream), callback(), target(NULL), buffer(capacity ? capacity : 1, '\0'), data(&(buffer[0])), filled(0), capacity(buffer.size()), drained(0), bounded(false), failed(false) {
+}
 
-  GlideJson::Type Null::getType() const {
-    return GlideJson::Null;
-  }
+GlideJsonSink::GlideJsonSink(const std::function<bool(const char *, size_t)> &callback) : GlideJsonSink(callback, GLIDE_JSON_SINK_CAPACITY) {
+}
 
-  std::string Null::toJson() const {
-    static const std::string nullString("null");
-    return nullString;
-  }
+GlideJsonSink::GlideJsonSink(const std::function<bool(const char *, size_t)> &callback, size_t capacity) : descriptor(-1), stream(NULL), callback(callback), target(NULL), buffer(capacity ? capacity : 1, '\0'), data(&(buffer[0])), filled(0), capacity(buffer.size()), drained(0), bounded(false), failed(false) {
+}
 
-  std::string Null::toJson(GlideJson::Whitespace type, size_t depth) const {
-    static const std::string nullString("null");
-    (void)type;
-    (void)depth;
-    return nullString;
-  }
+#ifdef GLIDE_JSON_POSIX
+GlideJsonSink::GlideJsonSink(int descriptor) : GlideJsonSink(descriptor, GLIDE_JSON_SINK_CAPACITY) {
+}
 
-  Null * Null::soleNull() {
-    static Null theOnlyNull;
-    return &theOnlyNull;
-  }
+GlideJsonSink::GlideJsonSink(int descriptor, size_t capacity) : descriptor(descriptor), stream(NULL), callback(), target(NULL), buffer(capacity ? capacity : 1, '\0'), data(&(buffer[0])), filled(0), capacity(buffer.size()), drained(0), bounded(false), failed(false) {
+}
+#endif
 
-  void Null::dispose() {
-  }
+GlideJsonSink::GlideJsonSink(const GlideJsonSink &input) : descriptor(-1), stream(NULL), callback(), target(NULL), buffer(), data(NULL), filled(0), capacity(0), drained(0), bounded(false), failed(false) {
+  (void)input;
+  throw GlideError("GlideJsonSink::GlideJsonSink(const GlideJsonSink &input): No copy constructor!");
+}
 
-  Null * Null::duplicate() const {
-    return soleNull();
-  }
+GlideJsonSink::~GlideJsonSink() {
+}
 
-  // ========================================
+GlideJsonSink & GlideJsonSink::operator=(const GlideJsonSink &input) {
+  (void)input;
+  throw GlideError("GlideJsonSink::operator=(const GlideJsonSink &input): No assignment operator!");
+  return *this;
+}
 
-  Boolean::Boolean() : Base(), boolean(false) {
+/*
+  Makes room for more output. Once writing fails, everything else is
+  discarded and "flush" reports the failure.
+*/
+void GlideJsonSink::drain() {
+  if(target) {
+    target->resize((capacity <<= 1));
+    data = &((*target)[0]);
+    return;
+  }
+  drained += filled;
+  if(bounded) {
+    // "buffer" is empty, so "data" stays valid without pointing anywhere:
+    failed = true;
+    data = &(buffer[0]);
+    capacity = 0;
+  }
+  else if(!failed && filled) {
+    if(stream) {
+      stream->write(data, filled);
+      failed = !stream->good();
+    }
+    else if(callback) {
+      failed = !callback(data, filled);
+    }
+    #ifdef GLIDE_JSON_POSIX
+    else {
+      size_t written(0);
+      ssize_t count;
+      while(written < filled) {
+        count = ::write(descriptor, data + written, filled - written);
+        if(count < 0) {
+          if(errno != EINTR) {
+            failed = true;
+            break;
+          }
+        }
+        else {
+          written += count;
+        }
+      }
+    }
+    #endif
   }
+  filled = 0;
+}
 
-  Boolean::Boolean(bool input) : Base(), boolean(input) {
+// Writes out whatever is left, and returns false if any write failed:
+bool GlideJsonSink::flush() {
+  if(!target) {
+    drain();
+    if(stream && !failed) {
+      failed = !stream->flush().good();
+    }
   }
+  return !failed;
+}
 
-  Boolean::Boolean(const Boolean &input) : Base(), boolean(input.boolean) {
-  }
+#undef GLIDE_JSON_SINK_CAPACITY
 
-  Boolean::~Boolean() {
-  }
+// ========================================
 
-  Boolean & Boolean::operator=(const Boolean &input) {
-    boolean = input.boolean;
-    return *this;
-  }
+/*
+  The defaults match "GlideJson::SpaceLf". Setting "inlineArrays" keeps
+  arrays of up to that many scalars on one line.
+*/
+GlideJsonStyle::GlideJsonStyle() : width(2), tabs(false), crlf(false), inlineArrays(0) {
+}
 
-  GlideJson::Type Boolean::getType() const {
-    return GlideJson::Boolean;
+GlideJsonStyle::GlideJsonStyle(GlideJson::Whitespace type) : width(2), tabs(false), crlf(false), inlineArrays(0) {
+  switch(type) {
+    case GlideJson::SpaceLf:
+      break;
+    case GlideJson::SpaceCrlf:
+      crlf = true;
+      break;
+    case GlideJson::TabLf:
+      width = 1;
+      tabs = true;
+      break;
+    case GlideJson::TabCrlf:
+      width = 1;
+      tabs = true;
+      crlf = true;
+      break;
+    default:
+      abort();
   }
+}
 
-  std::string Boolean::toJson() const {
-    static const std::string falseString("false");
-    static const std::string trueString("true");
-    return (boolean ? trueString : falseString);
-  }
+/*
+  Every indentation is copied out of the same two buffers, a block at a
+  time when it's deeper than they are:
+*/
+#define GLIDE_JSON_INDENT_SIZE ((size_t)1 << 8)
 
-  std::string Boolean::toJson(GlideJson::Whitespace type, size_t depth) const {
-    static const std::string falseString("false");
-    static const std::string trueString("true");
-    (void)type;
-    (void)depth;
-    return (boolean ? trueString : falseString);
+inline void GlideJsonStyle::newLine(GlideJsonSink &output, size_t depth) const {
+  static const std::string spaces(GLIDE_JSON_INDENT_SIZE, ' ');
+  static const std::string tabbed(GLIDE_JSON_INDENT_SIZE, '\t');
+  const char *indent(tabs ? tabbed.data() : spaces.data());
+  size_t count(width * depth);
+  if(crlf) {
+    output.append("\r\n", 2);
   }
-
-  const bool & Boolean::theBoolean() const {
-    return boolean;
+  else {
+    output.append('\n');
   }
-
-  bool & Boolean::theBoolean() {
-    return boolean;
+  while(count > GLIDE_JSON_INDENT_SIZE) {
+    output.append(indent, GLIDE_JSON_INDENT_SIZE);
+    count -= GLIDE_JSON_INDENT_SIZE;
   }
+  output.append(indent, count);
+}
 
-  GlideLfs Boolean::booleanCache;
+#undef GLIDE_JSON_INDENT_SIZE
 
-  Boolean * Boolean::make() {
-    Boolean *output((Boolean *)(booleanCache.pop()));
-    if(output == NULL) {
-      output = new Boolean();
-    }
-    return output;
-  }
+// ========================================
 
-  void Boolean::dispose() {
-    boolean = false;
-    booleanCache.push(this);
-  }
+/*
+  The paths form a trie with the root at node 0. Since node 0 can never
+  be a child, a "wildcard" of 0 means there is none. A node is
+  "selected" when a path ends there, in which case everything below it
+  is selected as well.
+*/
+size_t GlideJsonSelector::addNode() {
+  nodes.push_back(GlideJsonScheme::SelectorNode());
+  nodes.back().wildcard = 0;
+  nodes.back().selected = false;
+  return nodes.size() - 1;
+}
 
-  Boolean * Boolean::duplicate() const {
-    Boolean *output((Boolean *)(booleanCache.pop()));
-    if(output == NULL) {
-      output = new Boolean();
-    }
-    output->boolean = boolean;
-    return output;
+GlideJsonSelector::GlideJsonSelector() : nodes() {
+  addNode();
+}
+
+GlideJsonSelector::GlideJsonSelector(const std::vector<std::string> &paths) : nodes() {
+  addNode();
+  size_t i(0);
+  size_t size(paths.size());
+  while(i < size) {
+    add(paths[i]);
+    ++i;
   }
+}
 
-  // ========================================
+GlideJsonSelector::GlideJsonSelector(const GlideJsonSelector &input) : nodes(input.nodes) {
+}
 
-  Number::Number() : Base(), number("0") {
-  }
+GlideJsonSelector::~GlideJsonSelector() {
+}
 
-  Number::Number(const std::string &input) : Base(), number() {
-    GlideJson parsed(GlideJson::parse(input));
-    if(parsed.content->getType() == GlideJson::Number) {
-      number = std::move(((Number *)(parsed.content))->number);
+GlideJsonSelector & GlideJsonSelector::operator=(const GlideJsonSelector &input) {
+  nodes = input.nodes;
+  return *this;
+}
+
+/*
+  Paths follow JSON Pointer (RFC 6901): "" is the whole document, and
+  "/a/0/b" is made of the tokens "a", "0", and "b", where "~1" stands for
+  '/' and "~0" for '~'. A token matches an object key or an array
+  position, and the token "*" matches all of them.
+*/
+void GlideJsonSelector::add(const std::string &path) {
+  size_t size(path.size());
+  if(size && (path[0] != '/')) {
+    throw GlideError("GlideJsonSelector::add(const std::string &path): The path must be empty or start with a '/'!");
+  }
+  size_t node(0);
+  size_t child;
+  size_t i(1);
+  std::string token;
+  while(i <= size) {
+    if((i == size) || (path[i] == '/')) {
+      if(token == "*") {
+        if(!nodes[node].wildcard) {
+          child = addNode();
+          nodes[node].wildcard = child;
+        }
+        node = nodes[node].wildcard;
+      }
+      else {
+        auto found(nodes[node].children.find(token));
+        if(found == nodes[node].children.end()) {
+          child = addNode();
+          nodes[node].children[token] = child;
+          node = child;
+        }
+        else {
+          node = found->second;
+        }
+      }
+      token.clear();
+    }
+    else if((path[i] == '~') && (i + 1 < size) && ((path[i + 1] == '0') | (path[i + 1] == '1'))) {
+      token += (path[i + 1] == '0') ? '~' : '/';
+      ++i;
     }
     else {
-      number = '0';
+      token += path[i];
     }
+    ++i;
   }
+  nodes[node].selected = true;
+}
 
-  Number::Number(int input) : Base(), number(std::to_string(input)) {
-  }
+// ========================================
 
-  Number::Number(unsigned int input) : Base(), number(std::to_string(input)) {
-  }
+GlideJsonTape::GlideJsonTape() : input(NULL), tape() {
+}
 
-  Number::Number(long int input) : Base(), number(std::to_string(input)) {
-  }
+GlideJsonTape::GlideJsonTape(const GlideJsonTape &input) {
+  (void)input;
+  throw GlideError("GlideJsonTape::GlideJsonTape(const GlideJsonTape &input): No copy constructor!");
+}
 
-  Number::Number(unsigned long int input) : Base(), number(std::to_string(input)) {
-  }
+GlideJsonTape::~GlideJsonTape() {
+}
 
-  Number::Number(const Number &input) : Base(), number(input.number) {
-  }
+GlideJsonTape & GlideJsonTape::operator=(const GlideJsonTape &input) {
+  (void)input;
+  throw GlideError("GlideJsonTape::operator=(const GlideJsonTape &input): No assignment operator!");
+  return *this;
+}
 
-  Number::Number(Number &&input) : Base(), number(std::move(input.number)) {
-  }
+GlideJson GlideJsonTape::parse(const std::string &input) {
+  return GlideJsonScheme::Parser::parse(input, *this);
+}
 
-  Number::~Number() {
-  }
+GlideJson GlideJsonTape::parse(const char *input, size_t size) {
+  return GlideJsonScheme::Parser::parse(input, size, *this);
+}
 
-  Number & Number::operator=(int input) {
-    number = std::to_string(input);
-    return *this;
-  }
+GlideJsonView GlideJsonTape::root() const {
+  return GlideJsonView(this, 0);
+}
 
-  Number & Number::operator=(unsigned int input) {
-    number = std::to_string(input);
-    return *this;
-  }
-
-  Number & Number::operator=(long int input) {
-    number = std::to_string(input);
-    return *this;
-  }
+// ========================================
 
-  Number & Number::operator=(unsigned long int input) {
-    number = std::to_string(input);
-    return *this;
-  }
+GlideJsonViewIterator::GlideJsonViewIterator(const GlideJsonTape *tape, size_t index, bool object) : tape(tape), index(index), object(object) {
+}
 
-  Number & Number::operator=(const Number &input) {
-    number = input.number;
-    return *this;
-  }
+GlideJsonViewIterator::GlideJsonViewIterator() : tape(NULL), index(0), object(false) {
+}
 
-  Number & Number::operator=(Number &&input) {
-    number = std::move(input.number);
-    return *this;
-  }
+bool GlideJsonViewIterator::operator==(const GlideJsonViewIterator &input) const {
+  return index == input.index;
+}
 
-  GlideJson::Type Number::getType() const {
-    return GlideJson::Number;
-  }
+bool GlideJsonViewIterator::operator!=(const GlideJsonViewIterator &input) const {
+  return index != input.index;
+}
 
-  std::string Number::toJson() const {
-    return number;
-  }
+void GlideJsonViewIterator::next() {
+  index = tape->tape[index + object].next;
+}
 
-  std::string Number::toJson(GlideJson::Whitespace type, size_t depth) const {
-    (void)type;
-    (void)depth;
-    return number;
+std::string GlideJsonViewIterator::key() const {
+  if(!object) {
+    throw GlideError("GlideJsonViewIterator::key(): This is NOT iterating over an object!");
   }
+  return GlideJsonView(tape, index).string();
+}
 
-  const std::string & Number::theNumber() const {
-    return number;
-  }
+GlideJsonView GlideJsonViewIterator::value() const {
+  return GlideJsonView(tape, index + object);
+}
 
-  bool Number::set(const std::string &input) {
-    GlideJson parsed(GlideJson::parse(input));
-    bool output(parsed.content->getType() == GlideJson::Number);
-    if(output) {
-      number = std::move(((Number *)(parsed.content))->number);
-    }
-    return output;
-  }
+// ========================================
 
-  bool Number::set(const char *input, size_t size) {
-    GlideJson parsed(GlideJson::parse(input, size));
-    bool output(parsed.content->getType() == GlideJson::Number);
-    if(output) {
-      number = std::move(((Number *)(parsed.content))->number);
-    }
-    return output;
-  }
+/*
+  A view is nothing more than a position on a tape. Values are decoded
+  from the input every time they are accessed, so anything accessed
+  repeatedly should be copied out. A default view, or a view of a tape
+  that failed to parse, behaves like an error.
+*/
+GlideJsonView::GlideJsonView(const GlideJsonTape *tape, size_t index) : tape(tape), index(index) {
+}
 
-  GlideLfs Number::numberCache;
+const GlideJsonScheme::TapeEntry & GlideJsonView::entry() const {
+  return tape->tape[index];
+}
 
-  Number * Number::make() {
-    Number *output((Number *)(numberCache.pop()));
-    if(output == NULL) {
-      output = new Number();
-    }
-    return output;
+// Compares a key on the tape without decoding it unless it has escapes:
+bool GlideJsonView::matches(size_t keyIndex, const std::string &key) const {
+  const GlideJsonScheme::TapeEntry &keyEntry(tape->tape[keyIndex]);
+  if(keyEntry.flag) {
+    return GlideJsonView(tape, keyIndex).string() == key;
   }
+  return (keyEntry.size == key.size()) && !std::memcmp(tape->input + keyEntry.offset, key.data(), key.size());
+}
 
-  void Number::dispose() {
-    number = '0';
-    numberCache.push(this);
-  }
+GlideJsonView::GlideJsonView() : tape(NULL), index(0) {
+}
 
-  Number * Number::duplicate() const {
-    Number *output((Number *)(numberCache.pop()));
-    if(output == NULL) {
-      output = new Number();
-    }
-    output->number = number;
-    return output;
+GlideJson::Type GlideJsonView::getType() const {
+  if((tape == NULL) || (index >= tape->tape.size())) {
+    return GlideJson::Error;
   }
+  return (GlideJson::Type)(entry().type);
+}
 
-  // ========================================
+bool GlideJsonView::isError() const {
+  return getType() == GlideJson::Error;
+}
 
-  String::String() : Base(), string() {
-  }
+bool GlideJsonView::isNull() const {
+  return getType() == GlideJson::Null;
+}
 
-  String::String(const std::string &input) : Base(), string(input) {
-  }
+bool GlideJsonView::isBoolean() const {
+  return getType() == GlideJson::Boolean;
+}
 
-  String::String(std::string &&input) : Base(), string(std::move(input)) {
-  }
+bool GlideJsonView::isNumber() const {
+  return getType() == GlideJson::Number;
+}
 
-  String::String(const String &input) : Base(), string(input.string) {
-  }
+bool GlideJsonView::isString() const {
+  return getType() == GlideJson::String;
+}
 
-  String::String(String &&input) : Base(), string(std::move(input.string)) {
-  }
+bool GlideJsonView::isArray() const {
+  return getType() == GlideJson::Array;
+}
 
-  String::~String() {
-  }
+bool GlideJsonView::isObject() const {
+  return getType() == GlideJson::Object;
+}
 
-  String & String::operator=(const String &input) {
-    string = input.string;
-    return *this;
+bool GlideJsonView::boolean() const {
+  if(getType() != GlideJson::Boolean) {
+    throw GlideError("GlideJsonView::boolean(): This is NOT a boolean!");
   }
+  return entry().flag;
+}
 
-  String & String::operator=(String &&input) {
-    string = std::move(input.string);
-    return *this;
+// The tape only has the text of a number, so its binary value is computed on demand:
+GlideJsonScheme::Number GlideJsonView::binary() const {
+  if(getType() != GlideJson::Number) {
+    throw GlideError("GlideJsonView::binary(): This is NOT a number!");
   }
+  GlideJsonScheme::Number output;
+  output.scan(tape->input + entry().offset, entry().size);
+  return output;
+}
 
-  GlideJson::Type String::getType() const {
-    return GlideJson::String;
+std::string GlideJsonView::number() const {
+  if(getType() != GlideJson::Number) {
+    throw GlideError("GlideJsonView::number(): This is NOT a number!");
   }
+  return std::string(tape->input + entry().offset, entry().size);
+}
 
-  std::string String::toJson() const {
-    return Encoder::encode(string);
+std::string GlideJsonView::string() const {
+  if(getType() != GlideJson::String) {
+    throw GlideError("GlideJsonView::string(): This is NOT a string!");
   }
-
-  std::string String::toJson(GlideJson::Whitespace type, size_t depth) const {
-    (void)type;
-    (void)depth;
-    return Encoder::encode(string);
+  const GlideJsonScheme::TapeEntry &stringEntry(entry());
+  if(!stringEntry.flag) {
+    return std::string(tape->input + stringEntry.offset, stringEntry.size);
   }
+  // The quotes are included so the parser decodes the escape sequences:
+  GlideJson decoded(GlideJson::parse(tape->input + stringEntry.offset - 1, stringEntry.size + 2));
+  return std::move(decoded.string());
+}
 
-  const std::string & String::theString() const {
-    return string;
-  }
+int GlideJsonView::toInt() const {
+  return std::stoi(number());
+}
 
-  std::string & String::theString() {
-    return string;
-  }
+unsigned int GlideJsonView::toUInt() const {
+  return std::stoul(number());
+}
 
-  GlideLfs String::stringCache;
+long int GlideJsonView::toLong() const {
+  return std::stol(number());
+}
 
-  String * String::make() {
-    String *output((String *)(stringCache.pop()));
-    if(output == NULL) {
-      output = new String();
-    }
-    return output;
-  }
+unsigned long int GlideJsonView::toULong() const {
+  return std::stoul(number());
+}
 
-  void String::dispose() {
-    string.clear();
-    stringCache.push(this);
+bool GlideJsonView::toInt(int &output) const {
+  if(getType() != GlideJson::Number) {
+    output = 0;
+    return false;
   }
+  return !binary().integer(output);
+}
 
-  String * String::duplicate() const {
-    String *output((String *)(stringCache.pop()));
-    if(output == NULL) {
-      output = new String();
-    }
-    output->string = string;
-    return output;
+bool GlideJsonView::toUInt(unsigned int &output) const {
+  if(getType() != GlideJson::Number) {
+    output = 0;
+    return false;
   }
+  return !binary().integer(output);
+}
 
-  // ========================================
-
-  Array::Array() : Base(), array() {
+bool GlideJsonView::toLong(long int &output) const {
+  if(getType() != GlideJson::Number) {
+    output = 0;
+    return false;
   }
+  return !binary().integer(output);
+}
 
-  Array::Array(const std::vector<GlideJson> &input) : Base(), array(input) {
+bool GlideJsonView::toULong(unsigned long int &output) const {
+  if(getType() != GlideJson::Number) {
+    output = 0;
+    return false;
   }
+  return !binary().integer(output);
+}
 
-  Array::Array(const Array &input) : Base(), array(input.array) {
+double GlideJsonView::toDouble() const {
+  double output;
+  if(binary().floating(output, tape->input + entry().offset, entry().size) == 2) {
+    throw GlideError("GlideJsonView::toDouble(): Out of range!");
   }
+  return output;
+}
 
-  Array::Array(Array &&input) : Base(), array(std::move(input.array)) {
+float GlideJsonView::toFloat() const {
+  float output;
+  if(binary().floating(output, tape->input + entry().offset, entry().size) == 2) {
+    throw GlideError("GlideJsonView::toFloat(): Out of range!");
   }
+  return output;
+}
 
-  Array::~Array() {
+bool GlideJsonView::toDouble(double &output) const {
+  if(getType() != GlideJson::Number) {
+    output = 0;
+    return false;
   }
+  return !binary().floating(output, tape->input + entry().offset, entry().size);
+}
 
-  Array & Array::operator=(const Array &input) {
-    array = input.array;
-    return *this;
+bool GlideJsonView::toFloat(float &output) const {
+  if(getType() != GlideJson::Number) {
+    output = 0;
+    return false;
   }
+  return !binary().floating(output, tape->input + entry().offset, entry().size);
+}
 
-  Array & Array::operator=(Array &&input) {
-    array = std::move(input.array);
-    return *this;
+size_t GlideJsonView::size() const {
+  switch(getType()) {
+    case GlideJson::Array:
+      return entry().count;
+    case GlideJson::Object:
+      return entry().count >> 1;
+    default:
+      throw GlideError("GlideJsonView::size(): This is NOT an array or object!");
   }
+}
 
-  GlideJson::Type Array::getType() const {
-    return GlideJson::Array;
+size_t GlideJsonView::count(const std::string &key) const {
+  if(getType() != GlideJson::Object) {
+    throw GlideError("GlideJsonView::count(const std::string &key): This is NOT an object!");
   }
-
-  /*
-    See the source file for comments:
-  */
-  #define GLIDE_JSON_NO_WHITESPACE
-  #include "Array.inc"
-  #undef GLIDE_JSON_NO_WHITESPACE
-
-  #define GLIDE_JSON_WHITESPACE
-  #include "Array.inc"
-  #undef GLIDE_JSON_WHITESPACE
-
-  const std::vector<GlideJson> & Array::theArray() const {
-    return array;
+  size_t i(index + 1);
+  size_t end(entry().next);
+  while(i < end) {
+    if(matches(i, key)) {
+      return 1;
+    }
+    i = tape->tape[i + 1].next;
   }
+  return 0;
+}
 
-  std::vector<GlideJson> & Array::theArray() {
-    return array;
+// Elements are found by skipping their predecessors, so this is linear:
+GlideJsonView GlideJsonView::at(size_t position) const {
+  if(getType() != GlideJson::Array) {
+    throw GlideError("GlideJsonView::at(size_t position): This is NOT an array!");
   }
-
-  GlideLfs Array::arrayCache;
-
-  Array * Array::make() {
-    Array *output((Array *)(arrayCache.pop()));
-    if(output == NULL) {
-      output = new Array();
-    }
-    return output;
+  if(position >= entry().count) {
+    throw std::out_of_range("GlideJsonView::at(size_t position): Out of range!");
   }
-
-  void Array::dispose() {
-    array.clear();
-    arrayCache.push(this);
+  size_t i(index + 1);
+  while(position) {
+    i = tape->tape[i].next;
+    --position;
   }
+  return GlideJsonView(tape, i);
+}
 
-  Array * Array::duplicate() const {
-    Array *output((Array *)(arrayCache.pop()));
-    if(output == NULL) {
-      output = new Array();
+/*
+  Like "GlideJson::parse", the last of any duplicate keys wins. So the
+  whole object is scanned, but only the keys are compared.
+*/
+GlideJsonView GlideJsonView::at(const std::string &key) const {
+  if(getType() != GlideJson::Object) {
+    throw GlideError("GlideJsonView::at(const std::string &key): This is NOT an object!");
+  }
+  size_t i(index + 1);
+  size_t end(entry().next);
+  size_t found(0);
+  while(i < end) {
+    if(matches(i, key)) {
+      found = i + 1;
     }
-    output->array = array;
-    return output;
+    i = tape->tape[i + 1].next;
   }
-
-  // ========================================
-
-  Object::Object() : Base(), object() {
+  if(!found) {
+    throw std::out_of_range("GlideJsonView::at(const std::string &key): No such key!");
   }
+  return GlideJsonView(tape, found);
+}
 
-  Object::Object(const GlideHashMap<GlideJson> &input) : Base(), object(input) {
-  }
+GlideJsonView GlideJsonView::operator[](size_t position) const {
+  return at(position);
+}
 
-  Object::Object(const Object &input) : Base(), object(input.object) {
-  }
+GlideJsonView GlideJsonView::operator[](const std::string &key) const {
+  return at(key);
+}
 
-  Object::Object(Object &&input) : Base(), object(std::move(input.object)) {
+GlideJsonViewIterator GlideJsonView::begin() const {
+  GlideJson::Type type(getType());
+  if((type != GlideJson::Array) & (type != GlideJson::Object)) {
+    throw GlideError("GlideJsonView::begin(): This is NOT an array or object!");
   }
+  return GlideJsonViewIterator(tape, index + 1, type == GlideJson::Object);
+}
 
-  Object::~Object() {
+GlideJsonViewIterator GlideJsonView::end() const {
+  GlideJson::Type type(getType());
+  if((type != GlideJson::Array) & (type != GlideJson::Object)) {
+    throw GlideError("GlideJsonView::end(): This is NOT an array or object!");
   }
+  return GlideJsonViewIterator(tape, entry().next, type == GlideJson::Object);
+}
 
-  Object & Object::operator=(const Object &input) {
-    object = input.object;
-    return *this;
+GlideJson GlideJsonView::toGlideJson() const {
+  GlideJson::Type type(getType());
+  if(type == GlideJson::Error) {
+    return GlideJson(GlideJson::Error);
   }
-
-  Object & Object::operator=(Object &&input) {
-    object = std::move(input.object);
-    return *this;
+  const GlideJsonScheme::TapeEntry &valueEntry(entry());
+  if(type == GlideJson::String) {
+    return GlideJson::parse(tape->input + valueEntry.offset - 1, valueEntry.size + 2);
   }
+  return GlideJson::parse(tape->input + valueEntry.offset, valueEntry.size);
+}
 
-  GlideJson::Type Object::getType() const {
-    return GlideJson::Object;
-  }
+// ========================================
 
-  /*
-    See the source file for comments:
-  */
-  #define GLIDE_JSON_NO_WHITESPACE
-  #include "Object.inc"
-  #undef GLIDE_JSON_NO_WHITESPACE
+namespace GlideJsonScheme {
 
-  #define GLIDE_JSON_WHITESPACE
-  #include "Object.inc"
-  #undef GLIDE_JSON_WHITESPACE
+  unsigned char Encoder::hexMap[] = {0};
+  unsigned char Encoder::stateMap[GLIDE_BYTE_SIZE * GLIDE_JSON_ENCODER_STATES] = {0};
+  unsigned char Encoder::b64eMap[] = {0};
+  unsigned char Encoder::b64dMap[GLIDE_BYTE_SIZE] = {0};
 
-  const GlideHashMap<GlideJson> & Object::theObject() const {
-    return object;
+  void Encoder::setEscapable(size_t state) {
+    // Control characters:
+    unsigned char i(0);
+    do {
+      stateMap[i + GLIDE_BYTE_SIZE * state] = 1;
+    }
+    while(++i <= 31);
+    // Special characters escaped with a backslash:
+    stateMap['"' + GLIDE_BYTE_SIZE * state] = 2;
+    stateMap['\\' + GLIDE_BYTE_SIZE * state] = 3;
+    stateMap['\b' + GLIDE_BYTE_SIZE * state] = 4;
+    stateMap['\f' + GLIDE_BYTE_SIZE * state] = 5;
+    stateMap['\n' + GLIDE_BYTE_SIZE * state] = 6;
+    stateMap['\r' + GLIDE_BYTE_SIZE * state] = 7;
+    stateMap['\t' + GLIDE_BYTE_SIZE * state] = 8;
   }
 
-  GlideHashMap<GlideJson> & Object::theObject() {
-    return object;
-  }
-
-  GlideLfs Object::objectCache;
-
-  Object * Object::make() {
-    Object *output((Object *)(objectCache.pop()));
-    if(output == NULL) {
-      output = new Object();
-    }
-    return output;
-  }
-
-  void Object::dispose() {
-    object.clear();
-    objectCache.push(this);
-  }
-
-  Object * Object::duplicate() const {
-    Object *output((Object *)(objectCache.pop()));
-    if(output == NULL) {
-      output = new Object();
-    }
-    output->object = object;
-    return output;
-  }
-
-  // ========================================
-
-  unsigned char Parser::hexMap[] = {0};
-  unsigned char Parser::stateMap[] = {0};
-  bool Parser::incompleteMap[] = {0};
-
-  void Parser::copyTransitions(const size_t &from, const size_t &to) {
+  void Encoder::copyTransitions(size_t from, size_t to) {
     size_t i(0);
     do {
       stateMap[i + GLIDE_BYTE_SIZE * to] = stateMap[i + GLIDE_BYTE_SIZE * from];
@@ -1506,488 +2066,4232 @@ namespace GlideJsonScheme {
     while(++i <= 255);
   }
 
-  void Parser::setWhitespace(const size_t &at, const size_t &next) {
-    stateMap['\t' + GLIDE_BYTE_SIZE * at] = next;
-    stateMap['\n' + GLIDE_BYTE_SIZE * at] = next;
-    stateMap['\r' + GLIDE_BYTE_SIZE * at] = next;
-    stateMap[' ' + GLIDE_BYTE_SIZE * at] = next;
-  }
-
   /*
-    This "Parser" is a FSM guided by a state map. The state map is always
-    the width of an unsigned char multiplied by the number of
-    states. Every character from an input string is mapped to a
-    state. State 0 is always a failure state. State 1 is the point of
-    entry.
+    This "Encoder" is a FSM guided by a state map. The state map is always
+    the width of an unsigned char multiplied by the number of states.
+    Every character from an input string is mapped to a state. The
+    conversion of strings to JSON strings is binary-safe, so this FSM has
+    no failure states. Literally any combination of bytes leads to a valid
+    UTF-8 JSON string.
+
+    Grammar for UTF-8 from RFC 3629:
+
+    UTF8-octets = *( UTF8-char )
+    UTF8-char   = UTF8-1 / UTF8-2 / UTF8-3 / UTF8-4
+    UTF8-1      = %x00-7F
+    UTF8-2      = %xC2-DF UTF8-tail
+    UTF8-3      = %xE0 %xA0-BF UTF8-tail /
+                  %xE1-EC 2( UTF8-tail ) /
+                  %xED %x80-9F UTF8-tail /
+                  %xEE-EF 2( UTF8-tail )
+    UTF8-4      = %xF0 %x90-BF 2( UTF8-tail ) /
+                  %xF1-F3 3( UTF8-tail ) /
+                  %xF4 %x80-8F 2( UTF8-tail )
+    UTF8-tail   = %x80-BF
   */
-  void Parser::initialize() {
-    // Initialize "incomplete map" to true:
+  void Encoder::initialize() {
+    // Map integers to hex characters:
     unsigned char i(0);
     do {
-      incompleteMap[i] = true;
+      hexMap[i] = i + 48;
     }
-    while(++i < GLIDE_JSON_PARSER_STATES);
-    // Mapping hex characters to integers:
-    i = '0';
+    while(++i <= 9);
+    i = 10;
     do {
-      hexMap[i] = i - 48;
+      hexMap[i] = i + 87;
     }
-    while(++i <= '9');
-    i = 'A';
+    while(++i <= 15);
+    // Escapable at state 0:
+    Encoder::setEscapable(0);
+    // Non-ASCII characters:
+    i = 128;
     do {
-      hexMap[i] = i - 55;
+      stateMap[i] = 9;
     }
-    while(++i <= 'F');
-    i = 'a';
+    while(++i <= 193);
+    i = 255;
     do {
-      hexMap[i] = i - 87;
+      stateMap[i] = 9;
     }
-    while(++i <= 'f');
-    // Null:
-    stateMap['n' + GLIDE_BYTE_SIZE] = 2;
-    stateMap['u' + GLIDE_BYTE_SIZE * 2] = 3;
-    stateMap['l' + GLIDE_BYTE_SIZE * 3] = 4;
-    stateMap['l' + GLIDE_BYTE_SIZE * 4] = 5;
-    incompleteMap[5] = false;
-    // False:
-    stateMap['f' + GLIDE_BYTE_SIZE] = 6;
-    stateMap['a' + GLIDE_BYTE_SIZE * 6] = 7;
-    stateMap['l' + GLIDE_BYTE_SIZE * 7] = 8;
-    stateMap['s' + GLIDE_BYTE_SIZE * 8] = 9;
-    stateMap['e' + GLIDE_BYTE_SIZE * 9] = 10;
-    incompleteMap[10] = false;
-    // True:
-    stateMap['t' + GLIDE_BYTE_SIZE] = 11;
-    stateMap['r' + GLIDE_BYTE_SIZE * 11] = 12;
-    stateMap['u' + GLIDE_BYTE_SIZE * 12] = 13;
-    stateMap['e' + GLIDE_BYTE_SIZE * 13] = 14;
-    incompleteMap[14] = false;
-    // Zero:
-    stateMap['0' + GLIDE_BYTE_SIZE] = 15;
-    incompleteMap[15] = false;
-    // Initial digit:
-    i = '1';
+    while(--i >= 245);
+    // UTF-8 pair:
+    i = 194;
     do {
-      stateMap[i + GLIDE_BYTE_SIZE] = 16;
+      stateMap[i] = 10;
     }
-    while(++i <= '9');
-    incompleteMap[16] = false;
-    // Negative:
-    stateMap['-' + GLIDE_BYTE_SIZE] = 17;
-    // Second digit:
-    i = '0';
+    while(++i <= 223);
+    // UTF-8 triple:
+    stateMap[224] = 12;
+    i = 160;
     do {
-      stateMap[i + GLIDE_BYTE_SIZE * 16] = 19;
+      stateMap[i + GLIDE_BYTE_SIZE * 12] = 15;
     }
-    while(++i <= '9');
-    incompleteMap[19] = false;
-    // Remaining digits:
-    i = '0';
+    while(++i <= 191);
+    i = 225;
     do {
-      stateMap[i + GLIDE_BYTE_SIZE * 19] = 19;
+      stateMap[i] = 13;
     }
-    while(++i <= '9');
-    // Negative zero:
-    stateMap['0' + GLIDE_BYTE_SIZE * 17] = 18;
-    incompleteMap[18] = false;
-    // Initial digit from negative:
-    i = '1';
+    while(++i <= 236);
+    stateMap[238] = 13;
+    stateMap[239] = 13;
+    stateMap[237] = 14;
+    i = 128;
     do {
-      stateMap[i + GLIDE_BYTE_SIZE * 17] = 19;
+      stateMap[i + GLIDE_BYTE_SIZE * 14] = 15;
     }
-    while(++i <= '9');
-    // Decimal point:
-    stateMap['.' + GLIDE_BYTE_SIZE * 15] = 20;
-    stateMap['.' + GLIDE_BYTE_SIZE * 16] = 20;
-    stateMap['.' + GLIDE_BYTE_SIZE * 18] = 20;
-    stateMap['.' + GLIDE_BYTE_SIZE * 19] = 20;
-    // Initial digit from decimal point:
-    i = '0';
+    while(++i <= 159);
+    // UTF-8 quad:
+    stateMap[240] = 17;
+    i = 144;
     do {
-      stateMap[i + GLIDE_BYTE_SIZE * 20] = 21;
+      stateMap[i + GLIDE_BYTE_SIZE * 17] = 20;
     }
-    while(++i <= '9');
-    incompleteMap[21] = false;
-    // Remaining digits from decimal point:
-    i = '0';
+    while(++i <= 191);
+    stateMap[241] = 18;
+    stateMap[242] = 18;
+    stateMap[243] = 18;
+    stateMap[244] = 19;
+    i = 128;
     do {
-      stateMap[i + GLIDE_BYTE_SIZE * 21] = 21;
+      stateMap[i + GLIDE_BYTE_SIZE * 19] = 20;
     }
-    while(++i <= '9');
-    // Exponent:
-    stateMap['E' + GLIDE_BYTE_SIZE * 15] = 22;
-    stateMap['e' + GLIDE_BYTE_SIZE * 15] = 22;
-    stateMap['E' + GLIDE_BYTE_SIZE * 16] = 22;
-    stateMap['e' + GLIDE_BYTE_SIZE * 16] = 22;
-    stateMap['E' + GLIDE_BYTE_SIZE * 18] = 22;
-    stateMap['e' + GLIDE_BYTE_SIZE * 18] = 22;
-    stateMap['E' + GLIDE_BYTE_SIZE * 19] = 22;
-    stateMap['e' + GLIDE_BYTE_SIZE * 19] = 22;
-    stateMap['E' + GLIDE_BYTE_SIZE * 21] = 22;
-    stateMap['e' + GLIDE_BYTE_SIZE * 21] = 22;
-    // Initial digit from exponent:
-    i = '0';
+    while(++i <= 143);
+    // Trailing UTF-8 bytes:
+    i = 128;
     do {
-      stateMap[i + GLIDE_BYTE_SIZE * 22] = 23;
+      stateMap[i + GLIDE_BYTE_SIZE * 10] = 11;
+      stateMap[i + GLIDE_BYTE_SIZE * 13] = 15;
+      stateMap[i + GLIDE_BYTE_SIZE * 15] = 16;
+      stateMap[i + GLIDE_BYTE_SIZE * 18] = 20;
+      stateMap[i + GLIDE_BYTE_SIZE * 20] = 21;
+      stateMap[i + GLIDE_BYTE_SIZE * 21] = 22;
     }
-    while(++i <= '9');
-    incompleteMap[23] = false;
-    // Exponent sign:
-    stateMap['+' + GLIDE_BYTE_SIZE * 22] = 24;
-    stateMap['-' + GLIDE_BYTE_SIZE * 22] = 24;
-    // Remaining digits from exponent:
-    i = '0';
+    while(++i <= 191);
+    // Invalid UTF-8 triple:
+    Encoder::setEscapable(12);
+    i = 128;
     do {
-      stateMap[i + GLIDE_BYTE_SIZE * 23] = 23;
+      stateMap[i + GLIDE_BYTE_SIZE * 12] = 9;
     }
-    while(++i <= '9');
-    // Initial digit from exponent sign:
-    i = '0';
+    while(++i <= 159);
+    i = 255;
     do {
-      stateMap[i + GLIDE_BYTE_SIZE * 24] = 23;
+      stateMap[i + GLIDE_BYTE_SIZE * 12] = 9;
     }
-    while(++i <= '9');
-    /*
-      In this initial state, a string is initialized then led to the
-      looping state 26. See "copyTransitions" below.
-    */
-    stateMap['"' + GLIDE_BYTE_SIZE] = 25;
-    // End of the string:
-    stateMap['"' + GLIDE_BYTE_SIZE * 26] = 27;
-    incompleteMap[27] = false;
-    // Escape sequence:
-    stateMap['\\' + GLIDE_BYTE_SIZE * 26] = 28;
-    // Every other ASCII character from codepoint 32 to 127:
-    i = 32;
+    while(--i >= 192);
+    Encoder::setEscapable(14);
+    i = 255;
     do {
-      if((i != '"') & (i != '\\')) {
-        stateMap[i + GLIDE_BYTE_SIZE * 26] = 26;
-      }
+      stateMap[i + GLIDE_BYTE_SIZE * 14] = 9;
     }
-    while(++i <= 127);
-    /*
-      Escape-sequence characters in JSON. Note that when an escape character
-      is properly matched, it leads to state 26 (see "copyTransitions"
-      below). In other words, the string simply continues when the escape
-      sequence is valid.
-    */
-    stateMap['"' + GLIDE_BYTE_SIZE * 28] = 29;
-    stateMap['\\' + GLIDE_BYTE_SIZE * 28] = 30;
-    stateMap['/' + GLIDE_BYTE_SIZE * 28] = 31;
-    stateMap['b' + GLIDE_BYTE_SIZE * 28] = 32;
-    stateMap['f' + GLIDE_BYTE_SIZE * 28] = 33;
-    stateMap['n' + GLIDE_BYTE_SIZE * 28] = 34;
-    stateMap['r' + GLIDE_BYTE_SIZE * 28] = 35;
-    stateMap['t' + GLIDE_BYTE_SIZE * 28] = 36;
-    /*
-      The escape sequence "\u0000", as shown, has 4 hex characters. But
-      there is a lot going on in this part of the FSM. Since this is a UTF-8
-      parser, these codepoints have to be decoded into UTF-8 sequences. This
-      part of the FSM can easily be condensed into 4 or less states that
-      contain follow-up if statements. But if statements, while simpler,
-      would defeat the purpose of the FSM, and almost certainly compromise
-      performance. So, to stay true to this strategy, the states must branch
-      out according to the number of bytes of the resulting UTF-8 sequence:
-
-      - The first state has two branches: one solely for '0' and another for
-        1-F. The latter branch eliminates the possibility that the sequence
-        decodes to less than 3 bytes.
-      - If the first character is '0', the following state has 3 branches: one
-        solely for '0', one for 1-7, and one for 8-F. At this point, the
-        sequence can have any number of bytes. '0' is 1 or 2 bytes, 0-7 is
-        always 2 bytes, and 8-F is always 3 bytes.
-      - The state after the second '0' character has two branches: one for 0-7
-        and another for 8-F. 0-7 is 1 byte, 8-F is 2 bytes.
-      - A final note: the "leaf" states all terminate the sequence after the
-        fourth hex character. There are 3 such states, and they correspond
-        directly to each UTF-8 byte count determined by the aforementioned
-        branching.
-    */
-    stateMap['u' + GLIDE_BYTE_SIZE * 28] = 37;
-    // Any hex character (except 37 => 38, see below):
-    i = '0';
+    while(--i >= 160);
+    // Invalid UTF-8 quad:
+    Encoder::setEscapable(17);
+    i = 128;
     do {
-      stateMap[i + GLIDE_BYTE_SIZE * 37] = 39;
-      stateMap[i + GLIDE_BYTE_SIZE * 39] = 40;
-      stateMap[i + GLIDE_BYTE_SIZE * 40] = 45;
-      stateMap[i + GLIDE_BYTE_SIZE * 41] = 43;
-      stateMap[i + GLIDE_BYTE_SIZE * 43] = 47;
-      stateMap[i + GLIDE_BYTE_SIZE * 44] = 46;
-      stateMap[i + GLIDE_BYTE_SIZE * 45] = 48;
+      stateMap[i + GLIDE_BYTE_SIZE * 17] = 9;
     }
-    while(++i <= '9');
-    i = 'A';
+    while(++i <= 143);
+    i = 255;
     do {
-      stateMap[i + GLIDE_BYTE_SIZE * 37] = 39;
-      stateMap[i + GLIDE_BYTE_SIZE * 39] = 40;
-      stateMap[i + GLIDE_BYTE_SIZE * 40] = 45;
-      stateMap[i + GLIDE_BYTE_SIZE * 41] = 43;
-      stateMap[i + GLIDE_BYTE_SIZE * 43] = 47;
-      stateMap[i + GLIDE_BYTE_SIZE * 44] = 46;
-      stateMap[i + GLIDE_BYTE_SIZE * 45] = 48;
+      stateMap[i + GLIDE_BYTE_SIZE * 17] = 9;
     }
-    while(++i <= 'F');
-    i = 'a';
+    while(--i >= 192);
+    Encoder::setEscapable(19);
+    i = 255;
     do {
-      stateMap[i + GLIDE_BYTE_SIZE * 37] = 39;
-      stateMap[i + GLIDE_BYTE_SIZE * 39] = 40;
-      stateMap[i + GLIDE_BYTE_SIZE * 40] = 45;
-      stateMap[i + GLIDE_BYTE_SIZE * 41] = 43;
-      stateMap[i + GLIDE_BYTE_SIZE * 43] = 47;
-      stateMap[i + GLIDE_BYTE_SIZE * 44] = 46;
-      stateMap[i + GLIDE_BYTE_SIZE * 45] = 48;
+      stateMap[i + GLIDE_BYTE_SIZE * 19] = 9;
     }
-    while(++i <= 'f');
-    // At state 37, only '0' branches to state 38:
-    stateMap['0' + GLIDE_BYTE_SIZE * 37] = 38;
-    // Only 0-7 (hex):
-    i = '0';
+    while(--i >= 144);
+    // Invalid trailing UTF-8 bytes:
+    Encoder::setEscapable(10);
+    Encoder::setEscapable(13);
+    Encoder::setEscapable(15);
+    Encoder::setEscapable(18);
+    Encoder::setEscapable(20);
+    Encoder::setEscapable(21);
+    i = 255;
     do {
-      stateMap[i + GLIDE_BYTE_SIZE * 38] = 41;
-      stateMap[i + GLIDE_BYTE_SIZE * 42] = 44;
+      stateMap[i + GLIDE_BYTE_SIZE * 10] = 9;
+      stateMap[i + GLIDE_BYTE_SIZE * 13] = 9;
+      stateMap[i + GLIDE_BYTE_SIZE * 15] = 9;
+      stateMap[i + GLIDE_BYTE_SIZE * 18] = 9;
+      stateMap[i + GLIDE_BYTE_SIZE * 20] = 9;
+      stateMap[i + GLIDE_BYTE_SIZE * 21] = 9;
     }
-    while(++i <= '7');
-    // At state 38, only '0' branches to state 42:
-    stateMap['0' + GLIDE_BYTE_SIZE * 38] = 42;
-    // Only 8-F (hex):
-    stateMap['8' + GLIDE_BYTE_SIZE * 38] = 40;
-    stateMap['8' + GLIDE_BYTE_SIZE * 42] = 43;
-    stateMap['9' + GLIDE_BYTE_SIZE * 38] = 40;
-    stateMap['9' + GLIDE_BYTE_SIZE * 42] = 43;
-    i = 'A';
+    while(--i >= 192);
+    /*
+      All the following states need to behave exactly the same as state
+      0. They all terminate handlers of special characters, so they need to
+      behave as though the FSM is at state 0 again.
+    */
+    Encoder::copyTransitions(0, 1);
+    Encoder::copyTransitions(0, 2);
+    Encoder::copyTransitions(0, 3);
+    Encoder::copyTransitions(0, 4);
+    Encoder::copyTransitions(0, 5);
+    Encoder::copyTransitions(0, 6);
+    Encoder::copyTransitions(0, 7);
+    Encoder::copyTransitions(0, 8);
+    Encoder::copyTransitions(0, 9);
+    Encoder::copyTransitions(0, 11);
+    Encoder::copyTransitions(0, 16);
+    Encoder::copyTransitions(0, 22);
+    // Base64 encoding map:
+    i = 0;
     do {
-      stateMap[i + GLIDE_BYTE_SIZE * 38] = 40;
-      stateMap[i + GLIDE_BYTE_SIZE * 42] = 43;
+      b64eMap[i] = i + 65;
+      b64dMap[i + 65] = i;
+    }
+    while(++i < 26);
+    i = 26;
+    do {
+      b64eMap[i] = i + 71;
+      b64dMap[i + 71] = i;
+    }
+    while(++i < 52);
+    i = 52;
+    do {
+      b64eMap[i] = i - 4;
+      b64dMap[i - 4] = i;
+    }
+    while(++i < 62);
+    b64eMap[62] = '+';
+    b64dMap['+'] = 62;
+    b64eMap[63] = '/';
+    b64dMap['/'] = 63;
+  }
+
+  Encoder::Encoder() {
+    throw GlideError("GlideJsonScheme::Encoder::Encoder(): No default constructor!");
+  }
+
+  Encoder::Encoder(const Encoder &input) {
+    (void)input;
+    throw GlideError("GlideJsonScheme::Encoder::Encoder(const Encoder &input): No copy constructor!");
+  }
+
+  Encoder::~Encoder() {
+  }
+
+  Encoder & Encoder::operator=(const Encoder &input) {
+    (void)input;
+    throw GlideError("GlideJsonScheme::Encoder::operator=(const Encoder &input): No assignment operator!");
+    return *this;
+  }
+
+  /*
+    See the source file for comments:
+  */
+  #define GLIDE_JSON_PART_STDSTRING
+  #include "Encoder.inc"
+  #undef GLIDE_JSON_PART_STDSTRING
+
+  #define GLIDE_JSON_PART_CSTRING
+  #include "Encoder.inc"
+  #undef GLIDE_JSON_PART_CSTRING
+
+  // ========================================
+
+  EncoderInitializer::EncoderInitializer() {
+    Encoder::initialize();
+  }
+
+  EncoderInitializer::EncoderInitializer(const EncoderInitializer &input) {
+    (void)input;
+    throw GlideError("GlideJsonScheme::EncoderInitializer::EncoderInitializer(const EncoderInitializer &input): No copy constructor!");
+  }
+
+  EncoderInitializer::~EncoderInitializer() {
+  }
+
+  EncoderInitializer & EncoderInitializer::operator=(const EncoderInitializer &input) {
+    (void)input;
+    throw GlideError("GlideJsonScheme::EncoderInitializer::operator=(const EncoderInitializer &input): No assignment operator!");
+    return *this;
+  }
+
+  const EncoderInitializer & EncoderInitializer::initializer() {
+    static const EncoderInitializer initializer;
+    return initializer;
+  }
+
+  // ========================================
+
+  Base::Base() : GlideLfsNode() {
+  }
+
+  Base::Base(const Base &input) : GlideLfsNode() {
+    (void)input;
+  }
+
+  Base::~Base() {
+  }
+
+  Base & Base::operator=(const Base &input) {
+    (void)input;
+    return *this;
+  }
+
+  GlideJson::Type Base::getType() const {
+    throw GlideError("GlideJsonScheme::Base::getType(): This is an abstract class!");
+    return GlideJson::Null;
+  }
+
+  void Base::toJson(GlideJsonSink &output) const {
+    (void)output;
+    throw GlideError("GlideJsonScheme::Base::toJson(GlideJsonSink &output): This is an abstract class!");
+  }
+
+  void Base::toJson(GlideJsonSink &output, const GlideJsonStyle &style, size_t depth) const {
+    (void)output;
+    (void)style;
+    (void)depth;
+    throw GlideError("GlideJsonScheme::Base::toJson(GlideJsonSink &output, const GlideJsonStyle &style, size_t depth): This is an abstract class!");
+  }
+
+  const std::string & Base::theError() const {
+    static const std::string nothing;
+    throw GlideError("GlideJsonScheme::Base::theError(): This is NOT a GlideJsonScheme::Error object!");
+    return nothing;
+  }
+
+  const bool & Base::theBoolean() const {
+    static const bool nothing(false);
+    throw GlideError("GlideJsonScheme::Base::theBoolean(): This is NOT a GlideJsonScheme::Boolean object!");
+    return nothing;
+  }
+
+  bool & Base::theBoolean() {
+    static bool nothing(false);
+    throw GlideError("GlideJsonScheme::Base::theBoolean(): This is NOT a GlideJsonScheme::Boolean object!");
+    return nothing;
+  }
+
+  const std::string & Base::theNumber() const {
+    static const std::string nothing;
+    throw GlideError("GlideJsonScheme::Base::theNumber(): This is NOT a GlideJsonScheme::Number object!");
+    return nothing;
+  }
+
+  const std::string & Base::theString() const {
+    static const std::string nothing;
+    throw GlideError("GlideJsonScheme::Base::theString(): This is NOT a GlideJsonScheme::String object!");
+    return nothing;
+  }
+
+  std::string & Base::theString() {
+    static std::string nothing;
+    throw GlideError("GlideJsonScheme::Base::theString(): This is NOT a GlideJsonScheme::String object!");
+    return nothing;
+  }
+
+  const std::vector<GlideJson> & Base::theArray() const {
+    static const std::vector<GlideJson> nothing;
+    throw GlideError("GlideJsonScheme::Base::theArray(): This is NOT a GlideJsonScheme::Array object!");
+    return nothing;
+  }
+
+  std::vector<GlideJson> & Base::theArray() {
+    static std::vector<GlideJson> nothing;
+    throw GlideError("GlideJsonScheme::Base::theArray(): This is NOT a GlideJsonScheme::Array object!");
+    return nothing;
+  }
+
+  const GlideHashMap<GlideJson> & Base::theObject() const {
+    static const GlideHashMap<GlideJson> nothing;
+    throw GlideError("GlideJsonScheme::Base::theObject(): This is NOT a GlideJsonScheme::Object object!");
+    return nothing;
+  }
+
+  GlideHashMap<GlideJson> & Base::theObject() {
+    static GlideHashMap<GlideJson> nothing;
+    throw GlideError("GlideJsonScheme::Base::theObject(): This is NOT a GlideJsonScheme::Object object!");
+    return nothing;
+  }
+
+  void Base::remember(bool input) {
+    (void)input;
+    throw GlideError("GlideJsonScheme::Base::remember(bool input): This is NOT a GlideJsonScheme::Array or GlideJsonScheme::Object object!");
+  }
+
+  void Base::rememberTree(bool input) {
+    (void)input;
+    throw GlideError("GlideJsonScheme::Base::rememberTree(bool input): This is NOT a GlideJsonScheme::Array or GlideJsonScheme::Object object!");
+  }
+
+  void Base::dispose() {
+    throw GlideError("GlideJsonScheme::Base::dispose(void *input): This is an abstract class!");
+  }
+
+  Base * Base::duplicate() const {
+    throw GlideError("GlideJsonScheme::Base::duplicate(Base * &location): This is an abstract class!");
+  }
+
+  // ========================================
+
+  Error::Error() : Base(), error() {
+  }
+
+  Error::Error(const std::string &input) : Base(), error(input) {
+  }
+
+  Error::Error(const Error &input) : Base(), error(input.error) {
+  }
+
+  Error::Error(Error &&input) : Base(), error(std::move(input.error)) {
+  }
+
+  Error::~Error() {
+  }
+
+  Error & Error::operator=(const Error &input) {
+    error = input.error;
+    return *this;
+  }
+
+  Error & Error::operator=(Error &&input) {
+    error = std::move(input.error);
+    return *this;
+  }
+
+  GlideJson::Type Error::getType() const {
+    return GlideJson::Error;
+  }
+
+  void Error::toJson(GlideJsonSink &output) const {
+    Encoder::encode(error, output);
+  }
+
+  void Error::toJson(GlideJsonSink &output, const GlideJsonStyle &style, size_t depth) const {
+    (void)style;
+    (void)depth;
+    Encoder::encode(error, output);
+  }
+
+  const std::string & Error::theError() const {
+    return error;
+  }
+
+  GlideLfs Error::errorCache;
+
+  Error * Error::make() {
+    Error *output((Error *)(errorCache.pop()));
+    if(output == NULL) {
+      output = new Error();
+    }
+    return output;
+  }
+
+  void Error::dispose() {
+    error.clear();
+    errorCache.push(this);
+  }
+
+  Error * Error::duplicate() const {
+    Error *output((Error *)(errorCache.pop()));
+    if(output == NULL) {
+      output = new Error();
+    }
+    output->error = error;
+    return output;
+  }
+
+  // ========================================
+
+  Null::Null() : Base() {
+  }
+
+  Null::Null(const Null &input) : Base() {
+    (void)input;
+  }
+
+  Null::~Null() {
+  }
+
+  Null & Null::operator=(const Null &input) {
+    (void)input;
+    return *this;
+  }
+
+  GlideJson::Type Null::getType() const {
+    return GlideJson::Null;
+  }
+
+  void Null::toJson(GlideJsonSink &output) const {
+    output.append("null", 4);
+  }
+
+  void Null::toJson(GlideJsonSink &output, const GlideJsonStyle &style, size_t depth) const {
+    (void)style;
+    (void)depth;
+    output.append("null", 4);
+  }
+
+  Null * Null::soleNull() {
+    static Null theOnlyNull;
+    return &theOnlyNull;
+  }
+
+  void Null::dispose() {
+  }
+
+  Null * Null::duplicate() const {
+    return soleNull();
+  }
+
+  // ========================================
+
+  Boolean::Boolean() : Base(), boolean(false) {
+  }
+
+  Boolean::Boolean(bool input) : Base(), boolean(input) {
+  }
+
+  Boolean::Boolean(const Boolean &input) : Base(), boolean(input.boolean) {
+  }
+
+  Boolean::~Boolean() {
+  }
+
+  Boolean & Boolean::operator=(const Boolean &input) {
+    boolean = input.boolean;
+    return *this;
+  }
+
+  GlideJson::Type Boolean::getType() const {
+    return GlideJson::Boolean;
+  }
+
+  void Boolean::toJson(GlideJsonSink &output) const {
+    if(boolean) {
+      output.append("true", 4);
+    }
+    else {
+      output.append("false", 5);
+    }
+  }
+
+  void Boolean::toJson(GlideJsonSink &output, const GlideJsonStyle &style, size_t depth) const {
+    (void)style;
+    (void)depth;
+    toJson(output);
+  }
+
+  const bool & Boolean::theBoolean() const {
+    return boolean;
+  }
+
+  bool & Boolean::theBoolean() {
+    return boolean;
+  }
+
+  GlideLfs Boolean::booleanCache;
+
+  Boolean * Boolean::make() {
+    Boolean *output((Boolean *)(booleanCache.pop()));
+    if(output == NULL) {
+      output = new Boolean();
+    }
+    return output;
+  }
+
+  void Boolean::dispose() {
+    boolean = false;
+    booleanCache.push(this);
+  }
+
+  Boolean * Boolean::duplicate() const {
+    Boolean *output((Boolean *)(booleanCache.pop()));
+    if(output == NULL) {
+      output = new Boolean();
+    }
+    output->boolean = boolean;
+    return output;
+  }
+
+  // ========================================
+
+  /*
+    Next to its text, a number keeps its value in binary as it's parsed:
+    "mantissa" holds the digits without the decimal point, and the value
+    is "mantissa" times 10 to the power of "exponent" plus or minus
+    "explicitExponent" (the part after the 'e'). Digits stop being added
+    to "mantissa" once it would overflow ("saturated"). Any that follow
+    are dropped, which only changes "exponent" for the integer part, and
+    "truncated" records whether any of them wasn't zero.
+  */
+  const uint64_t Number::powers[20] = {
+    1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL,
+    100000000ULL, 1000000000ULL, 10000000000ULL, 100000000000ULL, 1000000000000ULL,
+    10000000000000ULL, 100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL,
+    100000000000000000ULL, 1000000000000000000ULL, 10000000000000000000ULL
+  };
+
+  inline void Number::clear() {
+    mantissa = 0;
+    exponent = 0;
+    explicitExponent = 0;
+    negative = false;
+    negativeExponent = false;
+    saturated = false;
+    truncated = false;
+  }
+
+  inline void Number::assign(bool isNegative, uint64_t magnitude) {
+    clear();
+    negative = isNegative;
+    mantissa = magnitude;
+  }
+
+  inline void Number::digits(const char *input, size_t size, bool fraction) {
+    static const uint64_t limit(std::numeric_limits<uint64_t>::max() / 10);
+    unsigned char digit;
+    size_t i(0);
+    while(i < size) {
+      digit = input[i] - '0';
+      if((!saturated) & ((mantissa < limit) | ((mantissa == limit) & (digit <= 5)))) {
+        mantissa = mantissa * 10 + digit;
+        exponent -= fraction;
+      }
+      else {
+        saturated = true;
+        exponent += !fraction;
+        truncated |= (digit != 0);
+      }
+      ++i;
+    }
+  }
+
+  inline void Number::exponentDigits(const char *input, size_t size) {
+    size_t i(0);
+    // Anything this large is out of range for every type anyway:
+    while((i < size) & (explicitExponent < 100000000)) {
+      explicitExponent = explicitExponent * 10 + (input[i] - '0');
+      ++i;
+    }
+  }
+
+  /*
+    Returns 0 if the value is an integer, 1 if it has a fraction (which is
+    dropped), and 2 if its magnitude doesn't even fit in 64 bits.
+  */
+  unsigned char Number::integerPart(uint64_t &magnitude) const {
+    int64_t power(exponent + (negativeExponent ? -(int64_t)explicitExponent : (int64_t)explicitExponent));
+    magnitude = mantissa;
+    if(!mantissa) {
+      return 0;
+    }
+    if(power >= 0) {
+      // A dropped digit that is part of the integer can only mean an overflow:
+      if((power > 19) || (saturated & (power > 0)) || (mantissa > std::numeric_limits<uint64_t>::max() / powers[power])) {
+        magnitude = std::numeric_limits<uint64_t>::max();
+        return 2;
+      }
+      magnitude = mantissa * powers[power];
+      return truncated;
+    }
+    if(power < -19) {
+      magnitude = 0;
+      return 1;
+    }
+    magnitude = mantissa / powers[-power];
+    return ((mantissa % powers[-power]) != 0) | truncated;
+  }
+
+  template<class T>
+  unsigned char Number::integer(T &output) const {
+    uint64_t magnitude;
+    unsigned char status(integerPart(magnitude));
+    uint64_t limit(std::numeric_limits<T>::max());
+    if(negative) {
+      // Unsigned types have no negative values at all:
+      limit = std::numeric_limits<T>::is_signed ? (limit + 1) : 0;
+    }
+    if(magnitude > limit) {
+      magnitude = limit;
+      status = 2;
+    }
+    if(negative & (magnitude > 0)) {
+      output = -(T)(magnitude - 1) - 1;
+    }
+    else {
+      output = (T)magnitude;
+    }
+    return status;
+  }
+
+  /*
+    The 128-bit mantissas of 5 to the power of -342 through 325, two words
+    each, the most significant first. "approximate" reads them up to 308,
+    and "shortest" reads the positive ones all the way. Positive powers
+    are truncated. Negative ones are 2^b / 5^-q for whichever b leaves 128
+    bits, plus one while 5^-q still fits in 64 bits. They're computed once
+    with schoolbook arithmetic on 32-bit words instead of being spelled
+    out as 1336 constants.
+  */
+  const uint64_t * Number::fives() {
+    static const std::vector<uint64_t> table([]() {
+      std::vector<uint64_t> output(2 * 668, 0);
+      std::vector<uint32_t> big(1, 1);
+      uint64_t carry;
+      uint64_t *entry;
+      size_t length;
+      size_t position;
+      size_t i;
+      int q;
+      auto top([&]() {
+        length = 32 * big.size();
+        while(!((big[(length - 1) / 32] >> ((length - 1) % 32)) & 1)) {
+          --length;
+        }
+        for(i = 0; (i < 128) & (i < length); ++i) {
+          position = length - 1 - i;
+          entry[i / 64] |= (uint64_t)((big[position / 32] >> (position % 32)) & 1) << (63 - i % 64);
+        }
+      });
+      for(q = 0; q <= 325; ++q) {
+        entry = output.data() + 2 * (q + 342);
+        top();
+        carry = 0;
+        for(i = 0; i < big.size(); ++i) {
+          carry += (uint64_t)(big[i]) * 5;
+          big[i] = (uint32_t)carry;
+          carry >>= 32;
+        }
+        if(carry) {
+          big.push_back((uint32_t)carry);
+        }
+      }
+      // 2^960 leaves more than 128 bits even after dividing by 5^342:
+      big.assign(31, 0);
+      big[30] = 1;
+      for(q = -1; q >= -342; --q) {
+        carry = 0;
+        for(i = big.size(); i > 0; --i) {
+          carry = (carry << 32) | big[i - 1];
+          big[i - 1] = (uint32_t)(carry / 5);
+          carry %= 5;
+        }
+        entry = output.data() + 2 * (q + 342);
+        top();
+        if(q >= -27) {
+          entry[0] += !++entry[1];
+        }
+      }
+      return output;
+    }());
+    return table.data();
+  }
+
+  inline uint64_t Number::product(uint64_t left, uint64_t right, uint64_t &high) {
+    #if defined(__GNUC__) && defined(__SIZEOF_INT128__)
+    __extension__ unsigned __int128 output((unsigned __int128)left * right);
+    high = (uint64_t)(output >> 64);
+    return (uint64_t)output;
+    #else
+    uint64_t leftLow(left & 0xFFFFFFFF);
+    uint64_t leftHigh(left >> 32);
+    uint64_t rightLow(right & 0xFFFFFFFF);
+    uint64_t rightHigh(right >> 32);
+    uint64_t lowLow(leftLow * rightLow);
+    uint64_t highLow(leftHigh * rightLow);
+    uint64_t lowHigh(leftLow * rightHigh);
+    uint64_t middle((lowLow >> 32) + (highLow & 0xFFFFFFFF) + (lowHigh & 0xFFFFFFFF));
+    high = leftHigh * rightHigh + (highLow >> 32) + (lowHigh >> 32) + (middle >> 32);
+    return (middle << 32) | (lowLow & 0xFFFFFFFF);
+    #endif
+  }
+
+  /*
+    Eisel and Lemire's conversion of "magnitude" times 10 to the power of
+    "power" into the bits of a double (52 mantissa bits) or a float (23),
+    sign excluded. The product with the truncated power of five is almost
+    always enough to round correctly. When it isn't, false is returned
+    and the caller has to take the slow path.
+  */
+  bool Number::approximate(uint64_t magnitude, int64_t power, int mantissaBits, uint64_t &bits) {
+    const bool single(mantissaBits != 52);
+    const int64_t minimumExponent(single ? -127 : -1023);
+    const int64_t infinitePower(single ? 0xFF : 0x7FF);
+    const uint64_t *five(Number::fives() + 2 * (power + 342));
+    const uint64_t mask(std::numeric_limits<uint64_t>::max() >> (mantissaBits + 3));
+    int zeros(__builtin_clzll(magnitude));
+    uint64_t high;
+    uint64_t low;
+    uint64_t secondHigh;
+    magnitude <<= zeros;
+    low = Number::product(magnitude, five[0], high);
+    if((high & mask) == mask) {
+      Number::product(magnitude, five[1], secondHigh);
+      low += secondHigh;
+      high += (secondHigh > low);
+    }
+    if((low == std::numeric_limits<uint64_t>::max()) & ((power < -27) | (power > 55))) {
+      return false;
+    }
+    int upper(high >> 63);
+    int shift(upper + 64 - mantissaBits - 3);
+    uint64_t mantissa(high >> shift);
+    int64_t exponent(((((152170 + 65536) * power) >> 16) + 63) + upper - zeros - minimumExponent);
+    if(exponent <= 0) {
+      // Subnormal, or zero if even the leading bit is shifted out:
+      if(-exponent + 1 >= 64) {
+        bits = 0;
+        return true;
+      }
+      mantissa >>= -exponent + 1;
+      mantissa += (mantissa & 1);
+      mantissa >>= 1;
+      exponent = (mantissa < (1ULL << mantissaBits)) ? 0 : 1;
+      bits = mantissa | ((uint64_t)exponent << mantissaBits);
+      return true;
+    }
+    // Exactly halfway is only possible for these powers, and rounds to even:
+    if((low <= 1) & (power >= (single ? -17 : -4)) & (power <= (single ? 10 : 23)) & ((mantissa & 3) == 1)) {
+      if((mantissa << shift) == high) {
+        mantissa &= ~1ULL;
+      }
+    }
+    mantissa += (mantissa & 1);
+    mantissa >>= 1;
+    if(mantissa >= (2ULL << mantissaBits)) {
+      mantissa = 1ULL << mantissaBits;
+      ++exponent;
+    }
+    mantissa &= ~(1ULL << mantissaBits);
+    if(exponent >= infinitePower) {
+      exponent = infinitePower;
+      mantissa = 0;
+    }
+    bits = mantissa | ((uint64_t)exponent << mantissaBits);
+    return true;
+  }
+
+  /*
+    Returns 0 if the value is in range and 2 if it overflows, in which case
+    "output" is the largest finite value of the sign. "input" is the text
+    the number was read from, which is only needed by the slow path.
+  */
+  template<class T>
+  unsigned char Number::floating(T &output, const char *input, size_t size) const {
+    static const double exact[23] = {
+      1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+      1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+    const int mantissaBits(std::numeric_limits<T>::digits - 1);
+    const bool single(mantissaBits != 52);
+    int64_t power(exponent + (negativeExponent ? -(int64_t)explicitExponent : (int64_t)explicitExponent));
+    int64_t fast(single ? 10 : 22);
+    uint64_t bits;
+    uint64_t nextBits;
+    T value;
+    if(!mantissa || (power < (single ? -65 : -342))) {
+      output = negative ? -(T)0 : (T)0;
+      return 0;
+    }
+    if(power > std::numeric_limits<T>::max_exponent10) {
+      output = negative ? -std::numeric_limits<T>::max() : std::numeric_limits<T>::max();
+      return 2;
+    }
+    // Both operands are exact here, so the one rounding is the right one:
+    if((!truncated) & (mantissa <= (2ULL << mantissaBits)) & (power >= -fast) & (power <= fast)) {
+      value = (T)mantissa;
+      value = (power < 0) ? (value / (T)exact[-power]) : (value * (T)exact[power]);
+      output = negative ? -value : value;
+      return 0;
+    }
+    bool approximated(Number::approximate(mantissa, power, mantissaBits, bits));
+    // Dropped digits put the value somewhere between "mantissa" and the next integer:
+    if(approximated & truncated) {
+      approximated = (mantissa != std::numeric_limits<uint64_t>::max())
+        && Number::approximate(mantissa + 1, power, mantissaBits, nextBits)
+        && (nextBits == bits);
+    }
+    if(approximated) {
+      bits |= (uint64_t)negative << (8 * sizeof(T) - 1);
+      typename std::conditional<sizeof(T) == sizeof(uint32_t), uint32_t, uint64_t>::type word(bits);
+      std::memcpy(&value, &word, sizeof(T));
+    }
+    else {
+      // The decimal point depends on the locale, so it's folded into the exponent:
+      std::string text;
+      int64_t fraction(0);
+      bool inFraction(false);
+      size_t i(0);
+      text.reserve(size + 24);
+      while((i < size) && (input[i] != 'e') && (input[i] != 'E')) {
+        if(input[i] == '.') {
+          inFraction = true;
+        }
+        else {
+          text += input[i];
+          fraction += inFraction;
+        }
+        ++i;
+      }
+      text += 'e';
+      text += std::to_string((negativeExponent ? -(int64_t)explicitExponent : (int64_t)explicitExponent) - fraction);
+      if(single) {
+        value = std::strtof(text.c_str(), NULL);
+      }
+      else {
+        value = std::strtod(text.c_str(), NULL);
+      }
+    }
+    if((value > std::numeric_limits<T>::max()) | (value < -std::numeric_limits<T>::max())) {
+      output = negative ? -std::numeric_limits<T>::max() : std::numeric_limits<T>::max();
+      return 2;
+    }
+    output = value;
+    return 0;
+  }
+
+  // The product of "multiplier" and the 128-bit "high":"low", shifted right by 64 to 127 bits:
+  inline uint64_t Number::shifted(uint64_t multiplier, uint64_t low, uint64_t high, int64_t shift) {
+    uint64_t lowHigh;
+    uint64_t highHigh;
+    Number::product(multiplier, low, lowHigh);
+    uint64_t highLow(Number::product(multiplier, high, highHigh));
+    highLow += lowHigh;
+    highHigh += (highLow < lowHigh);
+    shift -= 64;
+    return shift ? ((highLow >> shift) | (highHigh << (64 - shift))) : highLow;
+  }
+
+  inline bool Number::fiveDivides(uint64_t input, int64_t power) {
+    while(!(input % 5) & (power > 0)) {
+      input /= 5;
+      --power;
+    }
+    return !power;
+  }
+
+  /*
+    Ulf Adams' Ryu: the fewest "digits" times 10 to the power of "power"
+    that read back as the finite, nonzero double with "bits", sign
+    excluded, and the closest to it when there's a choice. The 125-bit
+    powers of five it multiplies by are the table's shifted right by 3,
+    with the inverse ones rounded up.
+  */
+  void Number::shortest(uint64_t bits, uint64_t &digits, int64_t &power) {
+    const uint64_t *table(Number::fives() + 2 * 342);
+    const uint64_t *entry;
+    uint64_t ieeeMantissa(bits & ((1ULL << 52) - 1));
+    int64_t ieeeExponent((bits >> 52) & 0x7FF);
+    uint64_t m2(ieeeExponent ? ((1ULL << 52) | ieeeMantissa) : ieeeMantissa);
+    int64_t e2((ieeeExponent ? ieeeExponent : 1) - 1023 - 52 - 2);
+    // The interval of values that round to the double is [mm, mp], shared by even mantissas:
+    bool even(!(m2 & 1));
+    uint64_t mv(4 * m2);
+    uint64_t mmShift((ieeeMantissa != 0) | (ieeeExponent <= 1));
+    uint64_t vr;
+    uint64_t vp;
+    uint64_t vm;
+    uint64_t low;
+    uint64_t high;
+    uint64_t top;
+    uint64_t bottom;
+    int64_t q;
+    int64_t i;
+    int64_t e10;
+    bool vmIsTrailingZeros(false);
+    bool vrIsTrailingZeros(false);
+    if(e2 >= 0) {
+      q = ((e2 * 78913) >> 18) - (e2 > 3);
+      e10 = q;
+      i = -e2 + q + 125 + ((q * 1217359) >> 19);
+      if(q) {
+        entry = table - 2 * q;
+        top = entry[0];
+        bottom = entry[1];
+        // Undoes the table's own rounding up before shifting:
+        if(q <= 27) {
+          top -= !bottom;
+          --bottom;
+        }
+        low = (bottom >> 3) | (top << 61);
+        high = top >> 3;
+      }
+      else {
+        low = 0;
+        high = 1ULL << 61;
+      }
+      high += !++low;
+      vr = Number::shifted(mv, low, high, i);
+      vp = Number::shifted(mv + 2, low, high, i);
+      vm = Number::shifted(mv - 1 - mmShift, low, high, i);
+      if(q <= 21) {
+        if(!(mv % 5)) {
+          vrIsTrailingZeros = Number::fiveDivides(mv, q);
+        }
+        else if(even) {
+          vmIsTrailingZeros = Number::fiveDivides(mv - 1 - mmShift, q);
+        }
+        else {
+          vp -= Number::fiveDivides(mv + 2, q);
+        }
+      }
+    }
+    else {
+      q = ((-e2 * 732923) >> 20) - (-e2 > 1);
+      e10 = q + e2;
+      i = -e2 - q;
+      entry = table + 2 * i;
+      low = (entry[1] >> 3) | (entry[0] << 61);
+      high = entry[0] >> 3;
+      i = q - ((i * 1217359) >> 19) - 1 + 125;
+      vr = Number::shifted(mv, low, high, i);
+      vp = Number::shifted(mv + 2, low, high, i);
+      vm = Number::shifted(mv - 1 - mmShift, low, high, i);
+      if(q <= 1) {
+        vrIsTrailingZeros = true;
+        if(even) {
+          vmIsTrailingZeros = (mmShift == 1);
+        }
+        else {
+          --vp;
+        }
+      }
+      else if(q < 63) {
+        vrIsTrailingZeros = !(mv & ((1ULL << q) - 1));
+      }
+    }
+    // Drops digits for as long as the interval still holds a number:
+    int64_t removed(0);
+    unsigned char lastRemovedDigit(0);
+    if(vmIsTrailingZeros | vrIsTrailingZeros) {
+      while((vp / 10) > (vm / 10)) {
+        vmIsTrailingZeros &= !(vm % 10);
+        vrIsTrailingZeros &= !lastRemovedDigit;
+        lastRemovedDigit = vr % 10;
+        vr /= 10;
+        vp /= 10;
+        vm /= 10;
+        ++removed;
+      }
+      if(vmIsTrailingZeros) {
+        while(!(vm % 10)) {
+          vrIsTrailingZeros &= !lastRemovedDigit;
+          lastRemovedDigit = vr % 10;
+          vr /= 10;
+          vp /= 10;
+          vm /= 10;
+          ++removed;
+        }
+      }
+      // Exactly halfway rounds to even:
+      if(vrIsTrailingZeros & (lastRemovedDigit == 5) & !(vr % 2)) {
+        lastRemovedDigit = 4;
+      }
+      digits = vr + (((vr == vm) & (!even | !vmIsTrailingZeros)) | (lastRemovedDigit >= 5));
+    }
+    else {
+      while((vp / 10) > (vm / 10)) {
+        lastRemovedDigit = vr % 10;
+        vr /= 10;
+        vp /= 10;
+        vm /= 10;
+        ++removed;
+      }
+      digits = vr + ((vr == vm) | (lastRemovedDigit >= 5));
+    }
+    power = e10 + removed;
+  }
+
+  Number::Number() : Base(), number("0") {
+    clear();
+  }
+
+  Number::Number(const std::string &input) : Base(), number() {
+    GlideJson parsed(GlideJson::parse(input));
+    if(parsed.content->getType() == GlideJson::Number) {
+      *this = std::move(*((Number *)(parsed.content)));
+    }
+    else {
+      number = '0';
+      clear();
+    }
+  }
+
+  Number::Number(int input) : Base(), number(std::to_string(input)) {
+    assign(input < 0, (input < 0) ? (0 - (uint64_t)(int64_t)input) : (uint64_t)input);
+  }
+
+  Number::Number(unsigned int input) : Base(), number(std::to_string(input)) {
+    assign(false, input);
+  }
+
+  Number::Number(long int input) : Base(), number(std::to_string(input)) {
+    assign(input < 0, (input < 0) ? (0 - (uint64_t)(int64_t)input) : (uint64_t)input);
+  }
+
+  Number::Number(unsigned long int input) : Base(), number(std::to_string(input)) {
+    assign(false, input);
+  }
+
+  Number::Number(double input) : Base(), number() {
+    *this = input;
+  }
+
+  Number::Number(const Number &input) : Base(), number(input.number), mantissa(input.mantissa), exponent(input.exponent), explicitExponent(input.explicitExponent), negative(input.negative), negativeExponent(input.negativeExponent), saturated(input.saturated), truncated(input.truncated) {
+  }
+
+  Number::Number(Number &&input) : Base(), number(std::move(input.number)), mantissa(input.mantissa), exponent(input.exponent), explicitExponent(input.explicitExponent), negative(input.negative), negativeExponent(input.negativeExponent), saturated(input.saturated), truncated(input.truncated) {
+  }
+
+  Number::~Number() {
+  }
+
+  Number & Number::operator=(int input) {
+    number = std::to_string(input);
+    assign(input < 0, (input < 0) ? (0 - (uint64_t)(int64_t)input) : (uint64_t)input);
+    return *this;
+  }
+
+  Number & Number::operator=(unsigned int input) {
+    number = std::to_string(input);
+    assign(false, input);
+    return *this;
+  }
+
+  Number & Number::operator=(long int input) {
+    number = std::to_string(input);
+    assign(input < 0, (input < 0) ? (0 - (uint64_t)(int64_t)input) : (uint64_t)input);
+    return *this;
+  }
+
+  Number & Number::operator=(unsigned long int input) {
+    number = std::to_string(input);
+    assign(false, input);
+    return *this;
+  }
+
+  /*
+    The text is the shortest that reads back as the same double, written
+    out in full from 1e-6 up to 1e21 and with an exponent otherwise, like
+    JavaScript does. JSON has no NaN or infinities, so they become 0 like
+    any other invalid number.
+  */
+  Number & Number::operator=(double input) {
+    char output[32];
+    char digits[20];
+    const char *first;
+    uint64_t bits;
+    uint64_t remaining;
+    int64_t scientific;
+    size_t size(0);
+    size_t count(0);
+    std::memcpy(&bits, &input, sizeof(bits));
+    clear();
+    if(((bits >> 52) & 0x7FF) == 0x7FF) {
+      number = '0';
+      return *this;
+    }
+    negative = bits >> 63;
+    if(negative) {
+      output[size++] = '-';
+    }
+    if(!(bits << 1)) {
+      output[size++] = '0';
+      number.assign(output, size);
+      return *this;
+    }
+    Number::shortest(bits, mantissa, exponent);
+    remaining = mantissa;
+    do {
+      digits[sizeof(digits) - ++count] = '0' + remaining % 10;
+      remaining /= 10;
+    }
+    while(remaining);
+    first = digits + sizeof(digits) - count;
+    scientific = exponent + (int64_t)count - 1;
+    if((scientific < -6) | (scientific >= 21)) {
+      output[size++] = first[0];
+      if(count > 1) {
+        output[size++] = '.';
+        std::memcpy(output + size, first + 1, count - 1);
+        size += count - 1;
+      }
+      output[size++] = 'e';
+      if(scientific < 0) {
+        output[size++] = '-';
+        scientific = -scientific;
+      }
+      if(scientific >= 100) {
+        output[size++] = '0' + scientific / 100;
+      }
+      if(scientific >= 10) {
+        output[size++] = '0' + (scientific / 10) % 10;
+      }
+      output[size++] = '0' + scientific % 10;
+    }
+    else if(exponent >= 0) {
+      std::memcpy(output + size, first, count);
+      size += count;
+      std::memset(output + size, '0', exponent);
+      size += exponent;
+    }
+    else if(scientific >= 0) {
+      std::memcpy(output + size, first, scientific + 1);
+      size += scientific + 1;
+      output[size++] = '.';
+      std::memcpy(output + size, first + scientific + 1, count - scientific - 1);
+      size += count - scientific - 1;
+    }
+    else {
+      output[size++] = '0';
+      output[size++] = '.';
+      std::memset(output + size, '0', -scientific - 1);
+      size += -scientific - 1;
+      std::memcpy(output + size, first, count);
+      size += count;
+    }
+    number.assign(output, size);
+    return *this;
+  }
+
+  Number & Number::operator=(const Number &input) {
+    number = input.number;
+    mantissa = input.mantissa;
+    exponent = input.exponent;
+    explicitExponent = input.explicitExponent;
+    negative = input.negative;
+    negativeExponent = input.negativeExponent;
+    saturated = input.saturated;
+    truncated = input.truncated;
+    return *this;
+  }
+
+  Number & Number::operator=(Number &&input) {
+    number = std::move(input.number);
+    mantissa = input.mantissa;
+    exponent = input.exponent;
+    explicitExponent = input.explicitExponent;
+    negative = input.negative;
+    negativeExponent = input.negativeExponent;
+    saturated = input.saturated;
+    truncated = input.truncated;
+    return *this;
+  }
+
+  GlideJson::Type Number::getType() const {
+    return GlideJson::Number;
+  }
+
+  void Number::toJson(GlideJsonSink &output) const {
+    output.append(number.data(), number.size());
+  }
+
+  void Number::toJson(GlideJsonSink &output, const GlideJsonStyle &style, size_t depth) const {
+    (void)style;
+    (void)depth;
+    output.append(number.data(), number.size());
+  }
+
+  const std::string & Number::theNumber() const {
+    return number;
+  }
+
+  bool Number::set(const std::string &input) {
+    GlideJson parsed(GlideJson::parse(input));
+    bool output(parsed.content->getType() == GlideJson::Number);
+    if(output) {
+      *this = std::move(*((Number *)(parsed.content)));
+    }
+    return output;
+  }
+
+  bool Number::set(const char *input, size_t size) {
+    GlideJson parsed(GlideJson::parse(input, size));
+    bool output(parsed.content->getType() == GlideJson::Number);
+    if(output) {
+      *this = std::move(*((Number *)(parsed.content)));
+    }
+    return output;
+  }
+
+  // Fills in the binary value of a number that is already known to be valid:
+  void Number::scan(const char *input, size_t size) {
+    size_t i(0);
+    size_t j;
+    clear();
+    if(input[i] == '-') {
+      negative = true;
+      ++i;
+    }
+    j = GlideScan::digits(input, i, size);
+    digits(input + i, j - i, false);
+    i = j;
+    if((i < size) && (input[i] == '.')) {
+      j = GlideScan::digits(input, ++i, size);
+      digits(input + i, j - i, true);
+      i = j;
+    }
+    if(i < size) {
+      ++i;
+      if((input[i] == '-') | (input[i] == '+')) {
+        negativeExponent = (input[i] == '-');
+        ++i;
+      }
+      exponentDigits(input + i, size - i);
+    }
+  }
+
+  GlideLfs Number::numberCache;
+
+  Number * Number::make() {
+    Number *output((Number *)(numberCache.pop()));
+    if(output == NULL) {
+      output = new Number();
+    }
+    return output;
+  }
+
+  void Number::dispose() {
+    number = '0';
+    clear();
+    numberCache.push(this);
+  }
+
+  Number * Number::duplicate() const {
+    Number *output((Number *)(numberCache.pop()));
+    if(output == NULL) {
+      output = new Number();
+    }
+    *output = *this;
+    return output;
+  }
+
+  // ========================================
+
+  String::String() : Base(), string() {
+  }
+
+  String::String(const std::string &input) : Base(), string(input) {
+  }
+
+  String::String(std::string &&input) : Base(), string(std::move(input)) {
+  }
+
+  String::String(const String &input) : Base(), string(input.string) {
+  }
+
+  String::String(String &&input) : Base(), string(std::move(input.string)) {
+  }
+
+  String::~String() {
+  }
+
+  String & String::operator=(const String &input) {
+    string = input.string;
+    return *this;
+  }
+
+  String & String::operator=(String &&input) {
+    string = std::move(input.string);
+    return *this;
+  }
+
+  GlideJson::Type String::getType() const {
+    return GlideJson::String;
+  }
+
+  void String::toJson(GlideJsonSink &output) const {
+    Encoder::encode(string, output);
+  }
+
+  void String::toJson(GlideJsonSink &output, const GlideJsonStyle &style, size_t depth) const {
+    (void)style;
+    (void)depth;
+    Encoder::encode(string, output);
+  }
+
+  const std::string & String::theString() const {
+    return string;
+  }
+
+  std::string & String::theString() {
+    return string;
+  }
+
+  GlideLfs String::stringCache;
+
+  String * String::make() {
+    String *output((String *)(stringCache.pop()));
+    if(output == NULL) {
+      output = new String();
+    }
+    return output;
+  }
+
+  void String::dispose() {
+    string.clear();
+    stringCache.push(this);
+  }
+
+  String * String::duplicate() const {
+    String *output((String *)(stringCache.pop()));
+    if(output == NULL) {
+      output = new String();
+    }
+    output->string = string;
+    return output;
+  }
+
+  // ========================================
+
+  /*
+    A string that was parsed without escape sequences, still sitting in the
+    input it was parsed from. "owner" keeps that input alive. The string is
+    only copied out of it the first time it's accessed as a std::string,
+    which may happen from several threads reading the same document, hence
+    the atomic "materialized":
+
+    - 0 when the string hasn't been copied,
+    - 1 while a thread is copying it,
+    - 2 once "string" is complete.
+
+    Duplicates are plain GlideJsonScheme::String objects, so only the parsed
+    document itself depends on the input.
+  */
+  StringView::StringView() : Base(), owner(), view(NULL), size(0), materialized(0), string() {
+  }
+
+  StringView::StringView(const StringView &input) : Base() {
+    (void)input;
+    throw GlideError("GlideJsonScheme::StringView::StringView(const StringView &input): No copy constructor!");
+  }
+
+  StringView::~StringView() {
+  }
+
+  StringView & StringView::operator=(const StringView &input) {
+    (void)input;
+    throw GlideError("GlideJsonScheme::StringView::operator=(const StringView &input): No assignment operator!");
+    return *this;
+  }
+
+  void StringView::materialize() const {
+    unsigned char expected(0);
+    if(materialized.load() == 2) {
+      return;
+    }
+    if(materialized.compare_exchange_strong(expected, 1)) {
+      string.assign(view, size);
+      materialized.store(2);
+    }
+    else {
+      while(materialized.load() != 2) {
+        std::this_thread::yield();
+      }
+    }
+  }
+
+  GlideJson::Type StringView::getType() const {
+    return GlideJson::String;
+  }
+
+  void StringView::toJson(GlideJsonSink &output) const {
+    if(materialized.load() == 2) {
+      Encoder::encode(string, output);
+    }
+    else {
+      Encoder::encode(view, size, output);
+    }
+  }
+
+  void StringView::toJson(GlideJsonSink &output, const GlideJsonStyle &style, size_t depth) const {
+    (void)style;
+    (void)depth;
+    toJson(output);
+  }
+
+  const std::string & StringView::theString() const {
+    materialize();
+    return string;
+  }
+
+  // A string that may be modified no longer needs the input:
+  std::string & StringView::theString() {
+    materialize();
+    owner.reset();
+    view = NULL;
+    return string;
+  }
+
+  GlideLfs StringView::stringViewCache;
+
+  StringView * StringView::make() {
+    StringView *output((StringView *)(stringViewCache.pop()));
+    if(output == NULL) {
+      output = new StringView();
+    }
+    return output;
+  }
+
+  void StringView::dispose() {
+    owner.reset();
+    view = NULL;
+    size = 0;
+    materialized.store(0);
+    string.clear();
+    stringViewCache.push(this);
+  }
+
+  String * StringView::duplicate() const {
+    String *output(String::make());
+    output->string = theString();
+    return output;
+  }
+
+  // ========================================
+
+  /*
+    A whole file, read-only. Regular files are mapped into memory and the
+    kernel is told they'll be read front to back, so it reads ahead
+    aggressively and the parser never waits on a copy. Anything else
+    (pipes, devices, or platforms without mmap) is read into "buffer"
+    through the descriptor already open. Directories are refused.
+  */
+  MappedFile::MappedFile() : data(NULL), size(0), buffer() {
+  }
+
+  MappedFile::MappedFile(const MappedFile &input) {
+    (void)input;
+    throw GlideError("GlideJsonScheme::MappedFile::MappedFile(const MappedFile &input): No copy constructor!");
+  }
+
+  MappedFile::~MappedFile() {
+    #ifdef GLIDE_JSON_POSIX
+    if(buffer.empty() && (size > 0)) {
+      munmap((void *)data, size);
+    }
+    #endif
+  }
+
+  MappedFile & MappedFile::operator=(const MappedFile &input) {
+    (void)input;
+    throw GlideError("GlideJsonScheme::MappedFile::operator=(const MappedFile &input): No assignment operator!");
+    return *this;
+  }
+
+  #ifdef GLIDE_JSON_POSIX
+  // Reads what's left of an open file that can't be mapped:
+  bool MappedFile::read(int file) {
+    size_t filled(0);
+    ssize_t count;
+    buffer.resize(GlideString::initialCapacity);
+    while(true) {
+      if(filled == buffer.size()) {
+        buffer.resize(filled << 1);
+      }
+      count = ::read(file, &(buffer[filled]), buffer.size() - filled);
+      if(count < 0) {
+        if(errno != EINTR) {
+          buffer.clear();
+          return false;
+        }
+      }
+      else if(count == 0) {
+        break;
+      }
+      else {
+        filled += count;
+      }
+    }
+    buffer.resize(filled);
+    data = buffer.data();
+    size = buffer.size();
+    return true;
+  }
+  #else
+  bool MappedFile::read(const std::string &path) {
+    std::ifstream file(path, std::ios::binary);
+    if(!file) {
+      return false;
+    }
+    // A failing read can throw out of the iterator rather than set "bad":
+    try {
+      buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+    catch(const std::ios_base::failure &) {
+      buffer.clear();
+      return false;
+    }
+    if(file.bad()) {
+      return false;
+    }
+    data = buffer.data();
+    size = buffer.size();
+    return true;
+  }
+  #endif
+
+  bool MappedFile::open(const std::string &path) {
+    #ifdef GLIDE_JSON_POSIX
+    struct stat status;
+    void *mapped;
+    bool output(true);
+    int file(::open(path.c_str(), O_RDONLY));
+    if(file < 0) {
+      return false;
+    }
+    if((fstat(file, &status) != 0) || S_ISDIR(status.st_mode)) {
+      output = false;
+    }
+    else if(!S_ISREG(status.st_mode)) {
+      output = read(file);
+    }
+    else if(status.st_size > 0) {
+      mapped = mmap(NULL, status.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+      if(mapped == MAP_FAILED) {
+        output = read(file);
+      }
+      else {
+        madvise(mapped, status.st_size, MADV_SEQUENTIAL);
+        data = (const char *)mapped;
+        size = status.st_size;
+      }
+    }
+    close(file);
+    return output;
+    #else
+    return read(path);
+    #endif
+  }
+
+  // ========================================
+
+  /*
+    Starts up to "count" threads running "work", besides the calling
+    thread. A thread that can't be created only means fewer of them, and
+    the caller should expect to do everything itself if "size" is 0.
+    Threads are always joined before the object goes away, and the first
+    exception any of them threw is rethrown by "join".
+  */
+  Workers::Workers(size_t count, const std::function<void()> &work) : work(work), pool(), lock(), failure() {
+    pool.reserve(count);
+    try {
+      while(pool.size() < count) {
+        pool.push_back(std::thread(&Workers::run, this));
+      }
+    }
+    catch(...) {
+      // Running out of threads or memory here is no reason to fail:
+    }
+  }
+
+  Workers::Workers(const Workers &input) {
+    (void)input;
+    throw GlideError("GlideJsonScheme::Workers::Workers(const Workers &input): No copy constructor!");
+  }
+
+  Workers::~Workers() {
+    size_t i(0);
+    while(i < pool.size()) {
+      if(pool[i].joinable()) {
+        pool[i].join();
+      }
+      ++i;
+    }
+  }
+
+  Workers & Workers::operator=(const Workers &input) {
+    (void)input;
+    throw GlideError("GlideJsonScheme::Workers::operator=(const Workers &input): No assignment operator!");
+    return *this;
+  }
+
+  void Workers::run() {
+    try {
+      work();
+    }
+    catch(...) {
+      std::lock_guard<std::mutex> guard(lock);
+      if(!failure) {
+        failure = std::current_exception();
+      }
+    }
+  }
+
+  size_t Workers::size() const {
+    return pool.size();
+  }
+
+  void Workers::join() {
+    size_t i(0);
+    while(i < pool.size()) {
+      if(pool[i].joinable()) {
+        pool[i].join();
+      }
+      ++i;
+    }
+    if(failure) {
+      std::rethrow_exception(failure);
+    }
+  }
+
+  // ========================================
+
+  /*
+    Only containers told to remember own one of these, so every other
+    container pays no more than a null pointer. The "state" follows the
+    same convention as the key memos: 0 when nothing is remembered, 1
+    while a thread is writing "bytes", and 2 once "bytes" may be copied
+    out. Copies carry over only finished bytes.
+  */
+  Remembered::Remembered() : state(0), bytes() {
+  }
+
+  Remembered::Remembered(const Remembered &input) : state(0), bytes() {
+    if(input.state.load() == 2) {
+      bytes = input.bytes;
+      state.store(2);
+    }
+  }
+
+  Remembered::~Remembered() {
+  }
+
+  Remembered & Remembered::operator=(const Remembered &input) {
+    (void)input;
+    throw GlideError("GlideJsonScheme::Remembered::operator=(const Remembered &input): No assignment operator!");
+  }
+
+  Remembered * Remembered::copy(const std::unique_ptr<Remembered> &input) {
+    if(input) {
+      return new Remembered(*input);
+    }
+    return NULL;
+  }
+
+  /*
+    Copies the remembered bytes of "owner" into "output" and returns true,
+    serializing "owner" into "bytes" first if nothing is remembered yet.
+    The state is 1 during that serialization, so the nested call to
+    "toJson" falls through to the ordinary encoder, as does any other
+    thread arriving meanwhile.
+  */
+  inline bool Remembered::recall(const Base &owner, GlideJsonSink &output) const {
+    unsigned char expected(state.load());
+    if(expected == 2) {
+      output.append(bytes.data(), bytes.size());
+      return true;
+    }
+    if(expected || !state.compare_exchange_strong(expected, 1)) {
+      return false;
+    }
+    bytes.clear();
+    GlideJsonSink sink(bytes);
+    owner.toJson(sink);
+    bytes.resize(sink.filled);
+    state.store(2);
+    output.append(bytes.data(), bytes.size());
+    return true;
+  }
+
+  // ========================================
+
+  Array::Array() : Base(), array(), remembered() {
+  }
+
+  Array::Array(const std::vector<GlideJson> &input) : Base(), array(input), remembered() {
+  }
+
+  Array::Array(const Array &input) : Base(), array(input.array), remembered(Remembered::copy(input.remembered)) {
+  }
+
+  Array::Array(Array &&input) : Base(), array(std::move(input.array)), remembered(std::move(input.remembered)) {
+  }
+
+  Array::~Array() {
+  }
+
+  Array & Array::operator=(const Array &input) {
+    array = input.array;
+    remembered.reset(Remembered::copy(input.remembered));
+    return *this;
+  }
+
+  Array & Array::operator=(Array &&input) {
+    array = std::move(input.array);
+    remembered = std::move(input.remembered);
+    return *this;
+  }
+
+  GlideJson::Type Array::getType() const {
+    return GlideJson::Array;
+  }
+
+  /*
+    See the source file for comments:
+  */
+  #define GLIDE_JSON_NO_WHITESPACE
+  #include "Array.inc"
+  #undef GLIDE_JSON_NO_WHITESPACE
+
+  #define GLIDE_JSON_WHITESPACE
+  #include "Array.inc"
+  #undef GLIDE_JSON_WHITESPACE
+
+  const std::vector<GlideJson> & Array::theArray() const {
+    return array;
+  }
+
+  /*
+    Every modification reaches the array through here, either right away
+    or through the reference it hands out, so this is where it stops
+    remembering its serialization:
+  */
+  std::vector<GlideJson> & Array::theArray() {
+    if(remembered) {
+      remembered.reset();
+    }
+    return array;
+  }
+
+  // A container still remembering hasn't been reached since, so it keeps its bytes:
+  void Array::remember(bool input) {
+    if(!input) {
+      remembered.reset();
+    }
+    else if(!remembered) {
+      remembered.reset(new Remembered());
+    }
+  }
+
+  // Reaches the elements directly, so none of them is turned off again:
+  void Array::rememberTree(bool input) {
+    GlideJson::Type type;
+    size_t i(0);
+    while(i < array.size()) {
+      type = array[i].content->getType();
+      if((type == GlideJson::Array) || (type == GlideJson::Object)) {
+        array[i].content->rememberTree(input);
+      }
+      ++i;
+    }
+    remember(input);
+  }
+
+  GlideLfs Array::arrayCache;
+
+  Array * Array::make() {
+    Array *output((Array *)(arrayCache.pop()));
+    if(output == NULL) {
+      output = new Array();
+    }
+    return output;
+  }
+
+  void Array::dispose() {
+    array.clear();
+    remembered.reset();
+    arrayCache.push(this);
+  }
+
+  Array * Array::duplicate() const {
+    Array *output((Array *)(arrayCache.pop()));
+    if(output == NULL) {
+      output = new Array();
+    }
+    output->array = array;
+    output->remembered.reset(Remembered::copy(remembered));
+    return output;
+  }
+
+  // ========================================
+
+  Object::Object() : Base(), object(), remembered() {
+  }
+
+  Object::Object(const GlideHashMap<GlideJson> &input) : Base(), object(input), remembered() {
+  }
+
+  Object::Object(const Object &input) : Base(), object(input.object), remembered(Remembered::copy(input.remembered)) {
+  }
+
+  Object::Object(Object &&input) : Base(), object(std::move(input.object)), remembered(std::move(input.remembered)) {
+  }
+
+  Object::~Object() {
+  }
+
+  Object & Object::operator=(const Object &input) {
+    object = input.object;
+    remembered.reset(Remembered::copy(input.remembered));
+    return *this;
+  }
+
+  Object & Object::operator=(Object &&input) {
+    object = std::move(input.object);
+    remembered = std::move(input.remembered);
+    return *this;
+  }
+
+  GlideJson::Type Object::getType() const {
+    return GlideJson::Object;
+  }
+
+  /*
+    The first serialization of a key keeps its encoding in the entry's
+    memo, and every later one copies it out. Should another thread be
+    writing the memo at the same time, the key is simply encoded again.
+  */
+  inline void Object::encodeKey(const GlideHashMapEntry<GlideJson> &entry, GlideJsonSink &output) {
+    unsigned char expected(entry.memoized.load());
+    if(expected == 2) {
+      output.append(entry.memo.data(), entry.memo.size());
+    }
+    else if(!expected && entry.memoized.compare_exchange_strong(expected, 1)) {
+      entry.memo = Encoder::encode(entry.first.value());
+      entry.memoized.store(2);
+      output.append(entry.memo.data(), entry.memo.size());
+    }
+    else {
+      Encoder::encode(entry.first.value(), output);
+    }
+  }
+
+  /*
+    See the source file for comments:
+  */
+  #define GLIDE_JSON_NO_WHITESPACE
+  #include "Object.inc"
+  #undef GLIDE_JSON_NO_WHITESPACE
+
+  #define GLIDE_JSON_WHITESPACE
+  #include "Object.inc"
+  #undef GLIDE_JSON_WHITESPACE
+
+  const GlideHashMap<GlideJson> & Object::theObject() const {
+    return object;
+  }
+
+  // As with arrays, handing out the map stops the remembering:
+  GlideHashMap<GlideJson> & Object::theObject() {
+    if(remembered) {
+      remembered.reset();
+    }
+    return object;
+  }
+
+  void Object::remember(bool input) {
+    if(!input) {
+      remembered.reset();
+    }
+    else if(!remembered) {
+      remembered.reset(new Remembered());
+    }
+  }
+
+  void Object::rememberTree(bool input) {
+    GlideJson::Type type;
+    auto i(object.begin());
+    auto iEnd(object.end());
+    while(i != iEnd) {
+      type = i.value().content->getType();
+      if((type == GlideJson::Array) || (type == GlideJson::Object)) {
+        i.value().content->rememberTree(input);
+      }
+      i.next();
+    }
+    remember(input);
+  }
+
+  GlideLfs Object::objectCache;
+
+  Object * Object::make() {
+    Object *output((Object *)(objectCache.pop()));
+    if(output == NULL) {
+      output = new Object();
+    }
+    return output;
+  }
+
+  void Object::dispose() {
+    object.clear();
+    remembered.reset();
+    objectCache.push(this);
+  }
+
+  Object * Object::duplicate() const {
+    Object *output((Object *)(objectCache.pop()));
+    if(output == NULL) {
+      output = new Object();
+    }
+    output->object = object;
+    output->remembered.reset(Remembered::copy(remembered));
+    return output;
+  }
+
+  // ========================================
+
+  unsigned char Parser::hexMap[] = {0};
+  unsigned char Parser::stateMap[] = {0};
+  bool Parser::incompleteMap[] = {0};
+
+  void Parser::copyTransitions(const size_t &from, const size_t &to) {
+    size_t i(0);
+    do {
+      stateMap[i + GLIDE_BYTE_SIZE * to] = stateMap[i + GLIDE_BYTE_SIZE * from];
+    }
+    while(++i <= 255);
+  }
+
+  void Parser::setWhitespace(const size_t &at, const size_t &next) {
+    stateMap['\t' + GLIDE_BYTE_SIZE * at] = next;
+    stateMap['\n' + GLIDE_BYTE_SIZE * at] = next;
+    stateMap['\r' + GLIDE_BYTE_SIZE * at] = next;
+    stateMap[' ' + GLIDE_BYTE_SIZE * at] = next;
+  }
+
+  /*
+    This "Parser" is a FSM guided by a state map. The state map is always
+    the width of an unsigned char multiplied by the number of
+    states. Every character from an input string is mapped to a
+    state. State 0 is always a failure state. State 1 is the point of
+    entry.
+  */
+  void Parser::initialize() {
+    // Initialize "incomplete map" to true:
+    unsigned char i(0);
+    do {
+      incompleteMap[i] = true;
+    }
+    while(++i < GLIDE_JSON_PARSER_STATES);
+    // Mapping hex characters to integers:
+    i = '0';
+    do {
+      hexMap[i] = i - 48;
+    }
+    while(++i <= '9');
+    i = 'A';
+    do {
+      hexMap[i] = i - 55;
+    }
+    while(++i <= 'F');
+    i = 'a';
+    do {
+      hexMap[i] = i - 87;
+    }
+    while(++i <= 'f');
+    // Null:
+    stateMap['n' + GLIDE_BYTE_SIZE] = 2;
+    stateMap['u' + GLIDE_BYTE_SIZE * 2] = 3;
+    stateMap['l' + GLIDE_BYTE_SIZE * 3] = 4;
+    stateMap['l' + GLIDE_BYTE_SIZE * 4] = 5;
+    incompleteMap[5] = false;
+    // False:
+    stateMap['f' + GLIDE_BYTE_SIZE] = 6;
+    stateMap['a' + GLIDE_BYTE_SIZE * 6] = 7;
+    stateMap['l' + GLIDE_BYTE_SIZE * 7] = 8;
+    stateMap['s' + GLIDE_BYTE_SIZE * 8] = 9;
+    stateMap['e' + GLIDE_BYTE_SIZE * 9] = 10;
+    incompleteMap[10] = false;
+    // True:
+    stateMap['t' + GLIDE_BYTE_SIZE] = 11;
+    stateMap['r' + GLIDE_BYTE_SIZE * 11] = 12;
+    stateMap['u' + GLIDE_BYTE_SIZE * 12] = 13;
+    stateMap['e' + GLIDE_BYTE_SIZE * 13] = 14;
+    incompleteMap[14] = false;
+    // Zero:
+    stateMap['0' + GLIDE_BYTE_SIZE] = 15;
+    incompleteMap[15] = false;
+    // Initial digit:
+    i = '1';
+    do {
+      stateMap[i + GLIDE_BYTE_SIZE] = 16;
+    }
+    while(++i <= '9');
+    incompleteMap[16] = false;
+    // Negative:
+    stateMap['-' + GLIDE_BYTE_SIZE] = 17;
+    // Second digit:
+    i = '0';
+    do {
+      stateMap[i + GLIDE_BYTE_SIZE * 16] = 19;
+    }
+    while(++i <= '9');
+    incompleteMap[19] = false;
+    // Remaining digits:
+    i = '0';
+    do {
+      stateMap[i + GLIDE_BYTE_SIZE * 19] = 19;
+    }
+    while(++i <= '9');
+    // Negative zero:
+    stateMap['0' + GLIDE_BYTE_SIZE * 17] = 18;
+    incompleteMap[18] = false;
+    // Initial digit from negative:
+    i = '1';
+    do {
+      stateMap[i + GLIDE_BYTE_SIZE * 17] = 19;
+    }
+    while(++i <= '9');
+    // Decimal point:
+    stateMap['.' + GLIDE_BYTE_SIZE * 15] = 20;
+    stateMap['.' + GLIDE_BYTE_SIZE * 16] = 20;
+    stateMap['.' + GLIDE_BYTE_SIZE * 18] = 20;
+    stateMap['.' + GLIDE_BYTE_SIZE * 19] = 20;
+    // Initial digit from decimal point:
+    i = '0';
+    do {
+      stateMap[i + GLIDE_BYTE_SIZE * 20] = 21;
+    }
+    while(++i <= '9');
+    incompleteMap[21] = false;
+    // Remaining digits from decimal point:
+    i = '0';
+    do {
+      stateMap[i + GLIDE_BYTE_SIZE * 21] = 21;
+    }
+    while(++i <= '9');
+    // Exponent:
+    stateMap['E' + GLIDE_BYTE_SIZE * 15] = 22;
+    stateMap['e' + GLIDE_BYTE_SIZE * 15] = 22;
+    stateMap['E' + GLIDE_BYTE_SIZE * 16] = 22;
+    stateMap['e' + GLIDE_BYTE_SIZE * 16] = 22;
+    stateMap['E' + GLIDE_BYTE_SIZE * 18] = 22;
+    stateMap['e' + GLIDE_BYTE_SIZE * 18] = 22;
+    stateMap['E' + GLIDE_BYTE_SIZE * 19] = 22;
+    stateMap['e' + GLIDE_BYTE_SIZE * 19] = 22;
+    stateMap['E' + GLIDE_BYTE_SIZE * 21] = 22;
+    stateMap['e' + GLIDE_BYTE_SIZE * 21] = 22;
+    // Initial digit from exponent:
+    i = '0';
+    do {
+      stateMap[i + GLIDE_BYTE_SIZE * 22] = 23;
+    }
+    while(++i <= '9');
+    incompleteMap[23] = false;
+    // Exponent sign:
+    stateMap['+' + GLIDE_BYTE_SIZE * 22] = 24;
+    stateMap['-' + GLIDE_BYTE_SIZE * 22] = 24;
+    // Remaining digits from exponent:
+    i = '0';
+    do {
+      stateMap[i + GLIDE_BYTE_SIZE * 23] = 23;
+    }
+    while(++i <= '9');
+    // Initial digit from exponent sign:
+    i = '0';
+    do {
+      stateMap[i + GLIDE_BYTE_SIZE * 24] = 23;
+    }
+    while(++i <= '9');
+    /*
+      In this initial state, a string is initialized then led to the
+      looping state 26. See "copyTransitions" below.
+    */
+    stateMap['"' + GLIDE_BYTE_SIZE] = 25;
+    // End of the string:
+    stateMap['"' + GLIDE_BYTE_SIZE * 26] = 27;
+    incompleteMap[27] = false;
+    // Escape sequence:
+    stateMap['\\' + GLIDE_BYTE_SIZE * 26] = 28;
+    // Every other ASCII character from codepoint 32 to 127:
+    i = 32;
+    do {
+      if((i != '"') & (i != '\\')) {
+        stateMap[i + GLIDE_BYTE_SIZE * 26] = 26;
+      }
+    }
+    while(++i <= 127);
+    /*
+      Escape-sequence characters in JSON. Note that when an escape character
+      is properly matched, it leads to state 26 (see "copyTransitions"
+      below). In other words, the string simply continues when the escape
+      sequence is valid.
+    */
+    stateMap['"' + GLIDE_BYTE_SIZE * 28] = 29;
+    stateMap['\\' + GLIDE_BYTE_SIZE * 28] = 30;
+    stateMap['/' + GLIDE_BYTE_SIZE * 28] = 31;
+    stateMap['b' + GLIDE_BYTE_SIZE * 28] = 32;
+    stateMap['f' + GLIDE_BYTE_SIZE * 28] = 33;
+    stateMap['n' + GLIDE_BYTE_SIZE * 28] = 34;
+    stateMap['r' + GLIDE_BYTE_SIZE * 28] = 35;
+    stateMap['t' + GLIDE_BYTE_SIZE * 28] = 36;
+    /*
+      The escape sequence "\u0000", as shown, has 4 hex characters. But
+      there is a lot going on in this part of the FSM. Since this is a UTF-8
+      parser, these codepoints have to be decoded into UTF-8 sequences. This
+      part of the FSM can easily be condensed into 4 or less states that
+      contain follow-up if statements. But if statements, while simpler,
+      would defeat the purpose of the FSM, and almost certainly compromise
+      performance. So, to stay true to this strategy, the states must branch
+      out according to the number of bytes of the resulting UTF-8 sequence:
+
+      - The first state has two branches: one solely for '0' and another for
+        1-F. The latter branch eliminates the possibility that the sequence
+        decodes to less than 3 bytes.
+      - If the first character is '0', the following state has 3 branches: one
+        solely for '0', one for 1-7, and one for 8-F. At this point, the
+        sequence can have any number of bytes. '0' is 1 or 2 bytes, 0-7 is
+        always 2 bytes, and 8-F is always 3 bytes.
+      - The state after the second '0' character has two branches: one for 0-7
+        and another for 8-F. 0-7 is 1 byte, 8-F is 2 bytes.
+      - A final note: the "leaf" states all terminate the sequence after the
+        fourth hex character. There are 3 such states, and they correspond
+        directly to each UTF-8 byte count determined by the aforementioned
+        branching.
+    */
+    stateMap['u' + GLIDE_BYTE_SIZE * 28] = 37;
+    // Any hex character (except 37 => 38, see below):
+    i = '0';
+    do {
+      stateMap[i + GLIDE_BYTE_SIZE * 37] = 39;
+      stateMap[i + GLIDE_BYTE_SIZE * 39] = 40;
+      stateMap[i + GLIDE_BYTE_SIZE * 40] = 45;
+      stateMap[i + GLIDE_BYTE_SIZE * 41] = 43;
+      stateMap[i + GLIDE_BYTE_SIZE * 43] = 47;
+      stateMap[i + GLIDE_BYTE_SIZE * 44] = 46;
+      stateMap[i + GLIDE_BYTE_SIZE * 45] = 48;
+    }
+    while(++i <= '9');
+    i = 'A';
+    do {
+      stateMap[i + GLIDE_BYTE_SIZE * 37] = 39;
+      stateMap[i + GLIDE_BYTE_SIZE * 39] = 40;
+      stateMap[i + GLIDE_BYTE_SIZE * 40] = 45;
+      stateMap[i + GLIDE_BYTE_SIZE * 41] = 43;
+      stateMap[i + GLIDE_BYTE_SIZE * 43] = 47;
+      stateMap[i + GLIDE_BYTE_SIZE * 44] = 46;
+      stateMap[i + GLIDE_BYTE_SIZE * 45] = 48;
+    }
+    while(++i <= 'F');
+    i = 'a';
+    do {
+      stateMap[i + GLIDE_BYTE_SIZE * 37] = 39;
+      stateMap[i + GLIDE_BYTE_SIZE * 39] = 40;
+      stateMap[i + GLIDE_BYTE_SIZE * 40] = 45;
+      stateMap[i + GLIDE_BYTE_SIZE * 41] = 43;
+      stateMap[i + GLIDE_BYTE_SIZE * 43] = 47;
+      stateMap[i + GLIDE_BYTE_SIZE * 44] = 46;
+      stateMap[i + GLIDE_BYTE_SIZE * 45] = 48;
+    }
+    while(++i <= 'f');
+    // At state 37, only '0' branches to state 38:
+    stateMap['0' + GLIDE_BYTE_SIZE * 37] = 38;
+    // Only 0-7 (hex):
+    i = '0';
+    do {
+      stateMap[i + GLIDE_BYTE_SIZE * 38] = 41;
+      stateMap[i + GLIDE_BYTE_SIZE * 42] = 44;
+    }
+    while(++i <= '7');
+    // At state 38, only '0' branches to state 42:
+    stateMap['0' + GLIDE_BYTE_SIZE * 38] = 42;
+    // Only 8-F (hex):
+    stateMap['8' + GLIDE_BYTE_SIZE * 38] = 40;
+    stateMap['8' + GLIDE_BYTE_SIZE * 42] = 43;
+    stateMap['9' + GLIDE_BYTE_SIZE * 38] = 40;
+    stateMap['9' + GLIDE_BYTE_SIZE * 42] = 43;
+    i = 'A';
+    do {
+      stateMap[i + GLIDE_BYTE_SIZE * 38] = 40;
+      stateMap[i + GLIDE_BYTE_SIZE * 42] = 43;
+    }
+    while(++i <= 'F');
+    i = 'a';
+    do {
+      stateMap[i + GLIDE_BYTE_SIZE * 38] = 40;
+      stateMap[i + GLIDE_BYTE_SIZE * 42] = 43;
+    }
+    while(++i <= 'f');
+    /*
+      Finally, make sure the JSON string is valid UTF-8 by mapping the
+      sequences in the remainder of the unicode range. We already took care
+      of control characters and one-byte sequences above. These remaining
+      branches are for 2 to 4 bytes.
+
+      Note that state 52 terminates all valid byte sequences then leads to
+      state 26. See "copyTransitions" below.
+
+      Grammar for UTF-8 from RFC 3629:
+
+      UTF8-octets = *( UTF8-char )
+      UTF8-char   = UTF8-1 / UTF8-2 / UTF8-3 / UTF8-4
+      UTF8-1      = %x00-7F
+      UTF8-2      = %xC2-DF UTF8-tail
+      UTF8-3      = %xE0 %xA0-BF UTF8-tail /
+                    %xE1-EC 2( UTF8-tail ) /
+                    %xED %x80-9F UTF8-tail /
+                    %xEE-EF 2( UTF8-tail )
+      UTF8-4      = %xF0 %x90-BF 2( UTF8-tail ) /
+                    %xF1-F3 3( UTF8-tail ) /
+                    %xF4 %x80-8F 2( UTF8-tail )
+      UTF8-tail   = %x80-BF
+    */
+    // UTF8-2      = %xC2-DF UTF8-tail
+    i = 194;
+    do {
+      stateMap[i + GLIDE_BYTE_SIZE * 26] = 49;
+    }
+    while(++i <= 223);
+    i = 128;
+    do {
+      stateMap[i + GLIDE_BYTE_SIZE * 49] = 52;
+    }
+    while(++i <= 191);
+    /*
+      UTF8-3      = %xE0 %xA0-BF UTF8-tail /
+                    %xE1-EC 2( UTF8-tail ) /
+                    %xED %x80-9F UTF8-tail /
+                    %xEE-EF 2( UTF8-tail )
+    */
+    stateMap[224 + GLIDE_BYTE_SIZE * 26] = 53;
+    i = 160;
+    do {
+      stateMap[i + GLIDE_BYTE_SIZE * 53] = 49;
+    }
+    while(++i <= 191);
+    //
+    i = 225;
+    do {
+      stateMap[i + GLIDE_BYTE_SIZE * 26] = 50;
+    }
+    while(++i <= 236);
+    stateMap[238 + GLIDE_BYTE_SIZE * 26] = 50;
+    stateMap[239 + GLIDE_BYTE_SIZE * 26] = 50;
+    i = 128;
+    do {
+      stateMap[i + GLIDE_BYTE_SIZE * 50] = 49;
+    }
+    while(++i <= 191);
+    //
+    stateMap[237 + GLIDE_BYTE_SIZE * 26] = 54;
+    i = 128;
+    do {
+      stateMap[i + GLIDE_BYTE_SIZE * 54] = 49;
+    }
+    while(++i <= 159);
+    /*
+      UTF8-4      = %xF0 %x90-BF 2( UTF8-tail ) /
+                    %xF1-F3 3( UTF8-tail ) /
+                    %xF4 %x80-8F 2( UTF8-tail )
+    */
+    stateMap[240 + GLIDE_BYTE_SIZE * 26] = 55;
+    i = 144;
+    do {
+      stateMap[i + GLIDE_BYTE_SIZE * 55] = 50;
+    }
+    while(++i <= 191);
+    //
+    stateMap[241 + GLIDE_BYTE_SIZE * 26] = 51;
+    stateMap[242 + GLIDE_BYTE_SIZE * 26] = 51;
+    stateMap[243 + GLIDE_BYTE_SIZE * 26] = 51;
+    i = 128;
+    do {
+      stateMap[i + GLIDE_BYTE_SIZE * 51] = 50;
+    }
+    while(++i <= 191);
+    //
+    stateMap[244 + GLIDE_BYTE_SIZE * 26] = 56;
+    i = 128;
+    do {
+      stateMap[i + GLIDE_BYTE_SIZE * 56] = 50;
+    }
+    while(++i <= 143);
+    /*
+      As noted above, the following states for parsing JSON strings need to
+      behave exactly the same as state 26. They merely continue string
+      parsing after a special case is handled successfully.
+    */
+    Parser::copyTransitions(26, 25);
+    Parser::copyTransitions(26, 29);
+    Parser::copyTransitions(26, 30);
+    Parser::copyTransitions(26, 31);
+    Parser::copyTransitions(26, 32);
+    Parser::copyTransitions(26, 33);
+    Parser::copyTransitions(26, 34);
+    Parser::copyTransitions(26, 35);
+    Parser::copyTransitions(26, 36);
+    Parser::copyTransitions(26, 46);
+    Parser::copyTransitions(26, 47);
+    Parser::copyTransitions(26, 48);
+    Parser::copyTransitions(26, 52);
+    /*
+      The following changes cover all whitespace scenarios:
+      - Making whitespace at state 1 loop back to state 1 to support
+        whitespace preceding all JSON elements, including most nested ones.
+      - A new state 66 to capture whitespace before a string acting as an
+        object key.
+      - A new state 67 to capture whitespace at the end of valid strings. The
+        separate state is necessary to provide for a colon when the string is
+        acting as an object key.
+      - A new state 68 to capture whitespace at the end of all valid JSON
+        elements except strings.
+
+      State 1 is defined right here since it must precede any calls to
+      "copyTransitions". The rest of the setup is mixed in with the
+      container definitions to make things a little easier to follow.
+    */
+    Parser::setWhitespace(1, 1);
+    /*
+      First, it's important to note that there is a lot of logic nested in
+      these container states. This is because there exists no FSM that
+      perfectly satisfies the definition of a JSON array or
+      object. Recursive patterns are impossible with FSMs. So, we define a
+      state machine that matches JSON arrays and objects, and use said logic
+      to enforce the recursive patterns.
+
+      The implementation below uses a stack for containers and a placeholder
+      for object keys. States 57, 58, 61, and 62 are hopefully
+      self-explanatory. States 59 and 63 are set as destinations for every
+      final state defined above since they terminate the two
+      containers. These two states can be reached regardless of whether or
+      not the appropriate container has been initialized. This is a symptom
+      of the whole recursive pattern dilemma detailed above. So checks are
+      performed as needed.
+
+      State 60 is for the comma, which is a separator for both JSON arrays
+      and objects. This is the same situation as states 59 and 63, but both
+      a JSON array and a JSON object must be handled here. In the case of a
+      JSON object, the state is edited to 64 to restrict the next element to
+      a string for the key. To enforce alternating keys and values, the
+      object key's placeholder must be null at this point.
+
+      State 65 for the colon terminates the object key and begins the
+      corresponding JSON element. The object key placeholder is set to null
+      to indicate that a new key can be parsed at the next comma.
+    */
+    stateMap['[' + GLIDE_BYTE_SIZE] = 57;
+    incompleteMap[58] = false;
+    incompleteMap[59] = false;
+    stateMap['{' + GLIDE_BYTE_SIZE] = 61;
+    stateMap['}' + GLIDE_BYTE_SIZE * 61] = 62;
+    incompleteMap[62] = false;
+    incompleteMap[63] = false;
+    stateMap['"' + GLIDE_BYTE_SIZE * 61] = 25;
+    stateMap['"' + GLIDE_BYTE_SIZE * 64] = 25;
+    stateMap['"' + GLIDE_BYTE_SIZE * 66] = 25;
+    Parser::setWhitespace(61, 66);
+    Parser::setWhitespace(64, 66);
+    Parser::setWhitespace(66, 66);
+    stateMap[':' + GLIDE_BYTE_SIZE * 27] = 65;
+    stateMap[':' + GLIDE_BYTE_SIZE * 67] = 65;
+    Parser::setWhitespace(27, 67);
+    Parser::setWhitespace(67, 67);
+    incompleteMap[67] = false;
+    Parser::copyTransitions(1, 57);
+    stateMap[']' + GLIDE_BYTE_SIZE * 57] = 58;
+    Parser::copyTransitions(1, 60);
+    Parser::copyTransitions(1, 65);
+    incompleteMap[68] = false;
+    i = 0;
+    do {
+      if(!incompleteMap[i]) {
+        stateMap[']' + GLIDE_BYTE_SIZE * i] = 59;
+        stateMap[',' + GLIDE_BYTE_SIZE * i] = 60;
+        stateMap['}' + GLIDE_BYTE_SIZE * i] = 63;
+        if((i != 27) & (i != 67)) {
+          Parser::setWhitespace(i, 68);
+        }
+      }
+    }
+    while(++i < GLIDE_JSON_PARSER_STATES);
+  }
+
+  Parser::Parser() {
+    throw GlideError("GlideJsonScheme::Parser::Parser(): No default constructor!");
+  }
+
+  Parser::Parser(const Parser &input) {
+    (void)input;
+    throw GlideError("GlideJsonScheme::Parser::Parser(const Parser &input): No copy constructor!");
+  }
+
+  Parser::~Parser() {
+  }
+
+  Parser & Parser::operator=(const Parser &input) {
+    (void)input;
+    throw GlideError("GlideJsonScheme::Parser::operator=(const Parser &input): No assignment operator!");
+    return *this;
+  }
+
+  /*
+    See the source file for comments:
+  */
+  #include "Parser.inc"
+
+  // ========================================
+
+  /*
+    The hooks of "Parser::scan", one for each kind of state. These do
+    nothing and accept everything, and every variant hides the ones it
+    has a use for:
+
+    - Parser::Builder builds a GlideJson for "feed", one chunk at a time,
+      and Parser::ViewBuilder lets its strings refer to the input.
+    - Parser::Emitter calls a GlideJsonHandler.
+    - Parser::Recorder fills a GlideJsonTape.
+    - Parser::Checker only decides whether the input is valid.
+    - Parser::Rebuilder overwrites an existing GlideJson in place.
+
+    "at" points to the byte that reached the state. The builders keep the
+    key in the document itself, and all the others use "key" to check
+    that keys and values alternate:
+
+    - 0 when no key is pending,
+    - 1 when a key is expected (after '{' or a comma in an object),
+    - 2 when a key was read and the colon is expected.
+  */
+  Parser::Actions::Actions() : key(0) {
+  }
+
+  Parser::Actions::Actions(const Actions &input) {
+    (void)input;
+    throw GlideError("GlideJsonScheme::Parser::Actions::Actions(const Actions &input): No copy constructor!");
+  }
+
+  Parser::Actions::~Actions() {
+  }
+
+  Parser::Actions & Parser::Actions::operator=(const Actions &input) {
+    (void)input;
+    throw GlideError("GlideJsonScheme::Parser::Actions::operator=(const Actions &input): No assignment operator!");
+    return *this;
+  }
+
+  inline void Parser::Actions::onNull(const char *at) {
+    (void)at;
+  }
+
+  inline void Parser::Actions::onBoolean(bool input, const char *at) {
+    (void)input;
+    (void)at;
+  }
+
+  inline bool Parser::Actions::onNumber(unsigned char state, const char *at) {
+    (void)state;
+    (void)at;
+    return true;
+  }
+
+  inline bool Parser::Actions::onNumberByte(unsigned char state, unsigned char input) {
+    (void)state;
+    (void)input;
+    return true;
+  }
+
+  inline bool Parser::Actions::onDigits(unsigned char state, const char *at, size_t size) {
+    (void)state;
+    (void)at;
+    (void)size;
+    return true;
+  }
+
+  inline void Parser::Actions::onNumberEnd(const char *at) {
+    (void)at;
+  }
+
+  inline bool Parser::Actions::onString(const char *at, const char *end) {
+    (void)at;
+    (void)end;
+    return true;
+  }
+
+  inline bool Parser::Actions::onVerbatim(const char *at, size_t size) {
+    (void)at;
+    (void)size;
+    return true;
+  }
+
+  inline bool Parser::Actions::onStringEnd(const char *at) {
+    (void)at;
+    if(key == 1) {
+      key = 2;
+    }
+    return true;
+  }
+
+  inline bool Parser::Actions::onEscape(const char *at) {
+    (void)at;
+    return true;
+  }
+
+  inline void Parser::Actions::onDecoded(unsigned char input) {
+    (void)input;
+  }
+
+  inline bool Parser::Actions::onMultibyte(unsigned char input) {
+    (void)input;
+    return true;
+  }
+
+  inline bool Parser::Actions::onArray(const char *at) {
+    (void)at;
+    return true;
+  }
+
+  inline void Parser::Actions::onEmptyArray(const char *at) {
+    (void)at;
+  }
+
+  inline bool Parser::Actions::onArrayEnd(const char *at) {
+    (void)at;
+    return true;
+  }
+
+  inline bool Parser::Actions::onComma(const char *at, unsigned char &state) {
+    (void)at;
+    (void)state;
+    return true;
+  }
+
+  inline bool Parser::Actions::onObject(const char *at) {
+    (void)at;
+    return true;
+  }
+
+  inline void Parser::Actions::onEmptyObject(const char *at) {
+    (void)at;
+  }
+
+  inline bool Parser::Actions::onObjectEnd(const char *at) {
+    (void)at;
+    return true;
+  }
+
+  inline bool Parser::Actions::onColon() {
+    if(key == 2) {
+      key = 0;
+      return true;
+    }
+    return false;
+  }
+
+  // ========================================
+
+  /*
+    "feed" resumes exactly where the previous chunk left it, so the state
+    of the builder is loaded from the GlideJsonParser here and stored back
+    by "store". Once the failure state 0 is reached, the rest of the input
+    is irrelevant and the index of the failure is already recorded.
+
+    Strings, keys, and numbers are decoded into "scratch", which belongs
+    to the parser and only grows until "reset" (see
+    GLIDE_JSON_SCRATCH_RETAINED). "decoded" is where the value ends
+    up, and it's copied there in one go once the value is complete. So
+    values are allocated at their exact size (or not at all when short
+    enough to fit inside the std::string), and the buffer is only
+    doubled when a value is longer than any seen before.
+
+    The limits are checked wherever something grows: the container stack
+    when a container opens, the element count when a slot is filled, and
+    the value being decoded ("fits") before a run of bytes is appended to
+    it, after a single byte is, and when a string ends. "bytes" is what
+    complete values have cost so far, so the value still being decoded is
+    added on top. Every value counts as GLIDE_JSON_NODE_BYTES toward
+    "GlideJsonLimits::bytes", which is what it costs at the very least,
+    plus the length of its text if any. Exceeding a limit is a failure
+    like any other, except that "exceeded" says which limit it was.
+  */
+  #define GLIDE_JSON_NODE_BYTES (sizeof(GlideJson) + sizeof(Number))
+
+  Parser::Builder::Builder(GlideJsonParser &parser) : Actions(), cOutput(parser.cOutput), decoded(parser.decoded), decodedSize(parser.decodedSize), decodedCapacity(parser.decodedCapacity), scratch(parser.scratch), objectKey(parser.objectKey), containers(parser.containers), limits(parser.limits), nodes(parser.nodes), bytes(parser.bytes), exceeded(0) {
+  }
+
+  Parser::Builder::~Builder() {
+  }
+
+  bool Parser::Builder::store(GlideJsonParser &parser, unsigned char state, unsigned short unicode, size_t finalIndex, size_t size) const {
+    parser.state = state;
+    parser.unicode = unicode;
+    parser.cOutput = cOutput;
+    parser.decodedSize = decodedSize;
+    parser.decodedCapacity = decodedCapacity;
+    parser.decoded = decoded;
+    parser.nodes = nodes;
+    parser.bytes = bytes;
+    if(!state) {
+      parser.exceeded = exceeded;
+      parser.finalIndex = parser.offset + finalIndex;
+    }
+    parser.offset += size;
+    return state;
+  }
+
+  inline bool Parser::Builder::fits(size_t run) {
+    if((decodedSize + run > limits.length) | (bytes + decodedSize + run > limits.bytes)) {
+      exceeded = (decodedSize + run > limits.length) ? 2 : 4;
+      return false;
+    }
+    return true;
+  }
+
+  // The value decoded so far is complete:
+  inline void Parser::Builder::settle() {
+    if(decoded) {
+      decoded->assign(scratch.data(), decodedSize);
+      bytes += decodedSize;
+      decoded = NULL;
+    }
+  }
+
+  inline bool Parser::Builder::fail(unsigned char input) {
+    exceeded = input;
+    return false;
+  }
+
+  inline void Parser::Builder::onNull(const char *at) {
+    (void)at;
+    // "cOutput" is only ever something else when a key is repeated:
+    if(cOutput->content->getType() != GlideJson::Null) {
+      *cOutput = GlideJson::Null;
+    }
+  }
+
+  inline void Parser::Builder::onBoolean(bool input, const char *at) {
+    (void)at;
+    *cOutput = GlideJson::Boolean;
+    *((Boolean *)(cOutput->content)) = input;
+  }
+
+  inline bool Parser::Builder::onNumber(unsigned char state, const char *at) {
+    settle();
+    *cOutput = GlideJson::Number;
+    decoded = &(((Number *)(cOutput->content))->number);
+    scratch[0] = *at;
+    decodedSize = 1;
+    /*
+      The binary value is built along with the text. A new Number is
+      zero, so only the sign or the first digit is missing:
+    */
+    ((Number *)(cOutput->content))->negative = (state == 17);
+    ((Number *)(cOutput->content))->mantissa = (state == 16) ? (*at - '0') : 0;
+    return fits(0);
+  }
+
+  inline bool Parser::Builder::onNumberByte(unsigned char state, unsigned char input) {
+    GlideString::append(input, decodedSize, decodedCapacity, scratch);
+    if(state == 24) {
+      ((Number *)(cOutput->content))->negativeExponent = (input == '-');
+    }
+    return fits(0);
+  }
+
+  inline bool Parser::Builder::onDigits(unsigned char state, const char *at, size_t size) {
+    if(!fits(size)) {
+      return false;
+    }
+    GlideString::append(at, size, decodedSize, decodedCapacity, scratch);
+    if(state == 23) {
+      ((Number *)(cOutput->content))->exponentDigits(at, size);
+    }
+    else {
+      ((Number *)(cOutput->content))->digits(at, size, state == 21);
+    }
+    return true;
+  }
+
+  inline bool Parser::Builder::onString(const char *at, const char *end) {
+    settle();
+    *cOutput = GlideJson::String;
+    decoded = &(((String *)(cOutput->content))->string);
+    decodedSize = 0;
+    return onVerbatim(at + 1, end - at - 1);
+  }
+
+  inline bool Parser::Builder::onVerbatim(const char *at, size_t size) {
+    if(!fits(size)) {
+      return false;
+    }
+    GlideString::append(at, size, decodedSize, decodedCapacity, scratch);
+    return true;
+  }
+
+  inline bool Parser::Builder::onStringEnd(const char *at) {
+    (void)at;
+    return fits(0);
+  }
+
+  inline bool Parser::Builder::onEscape(const char *at) {
+    (void)at;
+    // A string made of nothing but escape sequences never reaches state 26:
+    return fits(0);
+  }
+
+  inline void Parser::Builder::onDecoded(unsigned char input) {
+    GlideString::append(input, decodedSize, decodedCapacity, scratch);
+  }
+
+  inline bool Parser::Builder::onMultibyte(unsigned char input) {
+    GlideString::append(input, decodedSize, decodedCapacity, scratch);
+    // Nor does one made of nothing but multibyte characters:
+    return fits(0);
+  }
+
+  /*
+    "containers" holds one more than the depth, so this is the depth of
+    the new array. The array itself was counted when its slot was added.
+    Its first slot is counted right away, but only checked once a value
+    fills it (at state 59 or 60) since "[]" leaves it empty.
+  */
+  inline bool Parser::Builder::onArray(const char *at) {
+    (void)at;
+    if((containers.size() > limits.depth) | (nodes > limits.nodes) | (bytes > limits.bytes)) {
+      return fail((containers.size() > limits.depth) ? 1 : ((nodes > limits.nodes) ? 3 : 4));
+    }
+    ++nodes;
+    bytes += GLIDE_JSON_NODE_BYTES;
+    *cOutput = GlideJson::Array;
+    containers.push_back(cOutput);
+    std::vector<GlideJson> &array(((Array *)(cOutput->content))->array);
+    array.push_back(GlideJson());
+    cOutput = &(array.back());
+    return true;
+  }
+
+  // The slot added by "onArray" was never used:
+  inline void Parser::Builder::onEmptyArray(const char *at) {
+    (void)at;
+    --nodes;
+    bytes -= GLIDE_JSON_NODE_BYTES;
+    cOutput = containers.back();
+    containers.pop_back();
+    ((Array *)(cOutput->content))->array.pop_back();
+  }
+
+  inline bool Parser::Builder::onArrayEnd(const char *at) {
+    (void)at;
+    settle();
+    if((nodes > limits.nodes) | (bytes > limits.bytes)) {
+      return fail((nodes > limits.nodes) ? 3 : 4);
+    }
+    cOutput = containers.back();
+    containers.pop_back();
+    return cOutput->getType() == GlideJson::Array;
+  }
+
+  inline bool Parser::Builder::onComma(const char *at, unsigned char &state) {
+    (void)at;
+    settle();
+    cOutput = containers.back();
+    if(cOutput->getType() == GlideJson::Array) {
+      if((++nodes > limits.nodes) | ((bytes += GLIDE_JSON_NODE_BYTES) > limits.bytes)) {
+        return fail((nodes > limits.nodes) ? 3 : 4);
+      }
+      std::vector<GlideJson> &array(((Array *)(cOutput->content))->array);
+      array.push_back(GlideJson());
+      cOutput = &(array.back());
+      return true;
+    }
+    if((cOutput->getType() == GlideJson::Object) & (objectKey.getType() == GlideJson::Null)) {
+      state = 64;
+      cOutput = &objectKey;
+      return true;
+    }
+    return false;
+  }
+
+  inline bool Parser::Builder::onObject(const char *at) {
+    (void)at;
+    if((containers.size() > limits.depth) | (nodes > limits.nodes) | (bytes > limits.bytes)) {
+      return fail((containers.size() > limits.depth) ? 1 : ((nodes > limits.nodes) ? 3 : 4));
+    }
+    *cOutput = GlideJson::Object;
+    containers.push_back(cOutput);
+    cOutput = &objectKey;
+    return true;
+  }
+
+  inline void Parser::Builder::onEmptyObject(const char *at) {
+    (void)at;
+    containers.pop_back();
+  }
+
+  inline bool Parser::Builder::onObjectEnd(const char *at) {
+    (void)at;
+    settle();
+    cOutput = containers.back();
+    containers.pop_back();
+    // A key without a value can't close the object either:
+    return (cOutput->getType() == GlideJson::Object) & (objectKey.getType() == GlideJson::Null);
+  }
+
+  inline bool Parser::Builder::onColon() {
+    if(objectKey.getType() != GlideJson::String) {
+      return false;
+    }
+    if((++nodes > limits.nodes) | ((bytes += decodedSize + GLIDE_JSON_NODE_BYTES) > limits.bytes)) {
+      return fail((nodes > limits.nodes) ? 3 : 4);
+    }
+    // The key is still in "scratch" and goes straight into the object:
+    decoded = NULL;
+    cOutput = containers.back();
+    cOutput = &(((Object *)(cOutput->content))->object[std::string(scratch.data(), decodedSize)]);
+    objectKey = GlideJson::Null;
+    return true;
+  }
+
+  #undef GLIDE_JSON_NODE_BYTES
+
+  // ========================================
+
+  /*
+    Values refer to the input until an escape sequence shows up (see
+    "onEscape"). Keys are always decoded since GlideHashMap owns them.
+  */
+  Parser::ViewBuilder::ViewBuilder(GlideJsonParser &parser, const std::shared_ptr<const void> &owner) : Builder(parser), owner(owner), view(NULL) {
+  }
+
+  Parser::ViewBuilder::~ViewBuilder() {
+  }
+
+  inline bool Parser::ViewBuilder::onString(const char *at, const char *end) {
+    if(cOutput == &objectKey) {
+      return Builder::onString(at, end);
+    }
+    settle();
+    cOutput->content->dispose();
+    view = StringView::make();
+    cOutput->content = view;
+    view->owner = owner;
+    view->view = at + 1;
+    return true;
+  }
+
+  inline bool Parser::ViewBuilder::onVerbatim(const char *at, size_t size) {
+    if(view) {
+      return true;
+    }
+    return Builder::onVerbatim(at, size);
+  }
+
+  // Views cost nothing, but they're still held to the length limit:
+  inline bool Parser::ViewBuilder::onStringEnd(const char *at) {
+    if(view) {
+      view->size = at - view->view;
+      if(view->size > limits.length) {
+        return fail(2);
+      }
+      view = NULL;
+      return true;
+    }
+    return Builder::onStringEnd(at);
+  }
+
+  // The string has to be decoded after all, starting with what was skipped:
+  inline bool Parser::ViewBuilder::onEscape(const char *at) {
+    if(view) {
+      size_t skipped(at - view->view);
+      view = NULL;
+      *cOutput = GlideJson::String;
+      decoded = &(((String *)(cOutput->content))->string);
+      decodedSize = 0;
+      if(!Builder::onVerbatim(at - skipped, skipped)) {
+        return false;
+      }
+    }
+    return Builder::onEscape(at);
+  }
+
+  inline bool Parser::ViewBuilder::onMultibyte(unsigned char input) {
+    if(view) {
+      return true;
+    }
+    return Builder::onMultibyte(input);
+  }
+
+  bool Parser::feed(GlideJsonParser &parser, const std::string &input) {
+    return Parser::feed(parser, input.data(), input.size());
+  }
+
+  bool Parser::feed(GlideJsonParser &parser, const char *cInput, size_t size) {
+    static const ParserInitializer &parserInitializer(ParserInitializer::initializer());
+    (void)parserInitializer;
+    //
+    unsigned char state(parser.state);
+    unsigned short unicode(parser.unicode);
+    if(!state) {
+      return false;
+    }
+    Builder builder(parser);
+    size_t finalIndex(Parser::scan(builder, cInput, size, state, unicode));
+    return builder.store(parser, state, unicode, finalIndex, size);
+  }
+
+  bool Parser::feed(GlideJsonParser &parser, const std::shared_ptr<const void> &owner, const char *cInput, size_t size) {
+    static const ParserInitializer &parserInitializer(ParserInitializer::initializer());
+    (void)parserInitializer;
+    //
+    unsigned char state(parser.state);
+    unsigned short unicode(parser.unicode);
+    if(!state) {
+      return false;
+    }
+    ViewBuilder builder(parser, owner);
+    size_t finalIndex(Parser::scan(builder, cInput, size, state, unicode));
+    return builder.store(parser, state, unicode, finalIndex, size);
+  }
+
+  // ========================================
+
+  /*
+    No GlideJson is built here. The nesting is a plain stack of '[' and
+    '{', and strings are decoded into a single buffer that is reused for
+    every string. A number can't contain anything that needs decoding, so
+    it's handed over straight from the input once the FSM leaves it.
+  */
+  Parser::Emitter::Emitter(GlideJsonHandler &handler) : Actions(), handler(handler), number(NULL), containers(), decodedSize(0), decodedCapacity(GlideString::initialCapacity), decoded(decodedCapacity, '\0') {
+  }
+
+  Parser::Emitter::~Emitter() {
+  }
+
+  // Whatever is still open when the input ends makes it incomplete:
+  bool Parser::Emitter::finish(const char *end) {
+    if(!containers.empty()) {
+      return false;
+    }
+    onNumberEnd(end);
+    return true;
+  }
+
+  inline void Parser::Emitter::onNull(const char *at) {
+    (void)at;
+    handler.onNull();
+  }
+
+  inline void Parser::Emitter::onBoolean(bool input, const char *at) {
+    (void)at;
+    handler.onBoolean(input);
+  }
+
+  inline bool Parser::Emitter::onNumber(unsigned char state, const char *at) {
+    (void)state;
+    number = at;
+    return true;
+  }
+
+  inline void Parser::Emitter::onNumberEnd(const char *at) {
+    if(number) {
+      handler.onNumber(number, at - number);
+      number = NULL;
+    }
+  }
+
+  inline bool Parser::Emitter::onString(const char *at, const char *end) {
+    decodedSize = 0;
+    GlideString::append(at + 1, end - at - 1, decodedSize, decodedCapacity, decoded);
+    return true;
+  }
+
+  inline bool Parser::Emitter::onVerbatim(const char *at, size_t size) {
+    GlideString::append(at, size, decodedSize, decodedCapacity, decoded);
+    return true;
+  }
+
+  inline bool Parser::Emitter::onStringEnd(const char *at) {
+    (void)at;
+    if(key == 1) {
+      key = 2;
+      handler.onKey(decoded.data(), decodedSize);
+    }
+    else {
+      handler.onString(decoded.data(), decodedSize);
+    }
+    return true;
+  }
+
+  inline void Parser::Emitter::onDecoded(unsigned char input) {
+    GlideString::append(input, decodedSize, decodedCapacity, decoded);
+  }
+
+  inline bool Parser::Emitter::onMultibyte(unsigned char input) {
+    GlideString::append(input, decodedSize, decodedCapacity, decoded);
+    return true;
+  }
+
+  inline bool Parser::Emitter::onArray(const char *at) {
+    (void)at;
+    containers.push_back('[');
+    handler.onStartArray();
+    return true;
+  }
+
+  inline void Parser::Emitter::onEmptyArray(const char *at) {
+    (void)at;
+    containers.pop_back();
+    handler.onEndArray();
+  }
+
+  inline bool Parser::Emitter::onArrayEnd(const char *at) {
+    onNumberEnd(at);
+    if(containers.empty() || (containers.back() != '[')) {
+      return false;
+    }
+    containers.pop_back();
+    handler.onEndArray();
+    return true;
+  }
+
+  inline bool Parser::Emitter::onComma(const char *at, unsigned char &state) {
+    onNumberEnd(at);
+    if(containers.empty() || ((containers.back() == '{') & (key != 0))) {
+      return false;
+    }
+    if(containers.back() == '{') {
+      state = 64;
+      key = 1;
+    }
+    return true;
+  }
+
+  inline bool Parser::Emitter::onObject(const char *at) {
+    (void)at;
+    containers.push_back('{');
+    key = 1;
+    handler.onStartObject();
+    return true;
+  }
+
+  inline void Parser::Emitter::onEmptyObject(const char *at) {
+    (void)at;
+    containers.pop_back();
+    key = 0;
+    handler.onEndObject();
+  }
+
+  inline bool Parser::Emitter::onObjectEnd(const char *at) {
+    onNumberEnd(at);
+    if(containers.empty() || (containers.back() != '{') || key) {
+      return false;
+    }
+    containers.pop_back();
+    handler.onEndObject();
+    return true;
+  }
+
+  GlideJson Parser::parse(const std::string &input, GlideJsonHandler &handler) {
+    return Parser::parse(input.data(), input.size(), handler);
+  }
+
+  GlideJson Parser::parse(const char *cInput, size_t size, GlideJsonHandler &handler) {
+    static const ParserInitializer &parserInitializer(ParserInitializer::initializer());
+    (void)parserInitializer;
+    //
+    unsigned char state(size > 0);
+    unsigned short unicode(0);
+    Emitter emitter(handler);
+    size_t finalIndex(Parser::scan(emitter, cInput, size, state, unicode));
+    GlideJson output;
+    if(incompleteMap[state] || !emitter.finish(cInput + size)) {
+      output = GlideJson::Error;
+      ((GlideJsonScheme::Error *)(output.content))->error = "Parsing failed at index " + std::to_string(finalIndex) + "!";
+    }
+    return output;
+  }
+
+  // ========================================
+
+  /*
+    Every value becomes a single "TapeEntry" pointing back into the input:
+
+    - "offset" and "size" delimit the value's bytes. For strings, this is
+      the body between the quotes, and "flag" marks the presence of escape
+      sequences. For booleans, "flag" is the value.
+    - "count" is the number of direct children of a container, keys
+      included.
+    - "next" is the index of the entry that follows the value and all of
+      its children, so containers can be skipped in one step.
+
+    Nothing is decoded or allocated besides the tape itself. "containers"
+    holds the indices of the open containers' entries, and "number" that
+    of the number whose end is still unknown, if "numberPending".
+  */
+  Parser::Recorder::Recorder(GlideJsonTape &tape, const char *input) : Actions(), input(input), entries(tape.tape), containers(), number(0), numberPending(false) {
+    tape.input = input;
+    entries.clear();
+  }
+
+  Parser::Recorder::~Recorder() {
+  }
+
+  bool Parser::Recorder::finish(const char *end) {
+    if(!containers.empty()) {
+      return false;
+    }
+    onNumberEnd(end);
+    return true;
+  }
+
+  inline void Parser::Recorder::add(GlideJson::Type type, const char *at, size_t size, unsigned char flag) {
+    TapeEntry entry;
+    entry.type = type;
+    entry.flag = flag;
+    entry.offset = at - input;
+    entry.size = size;
+    entry.count = 0;
+    entry.next = entries.size() + 1;
+    if(!containers.empty()) {
+      ++(entries[containers.back()].count);
+    }
+    entries.push_back(entry);
+  }
+
+  // The size and "next" of a container are only known once it closes:
+  inline void Parser::Recorder::open(GlideJson::Type type, const char *at) {
+    add(type, at, 0, 0);
+    containers.push_back(entries.size() - 1);
+    key = (type == GlideJson::Object);
+  }
+
+  inline bool Parser::Recorder::close(GlideJson::Type type, const char *at) {
+    if(containers.empty() || (entries[containers.back()].type != type) || key) {
+      return false;
+    }
+    TapeEntry &entry(entries[containers.back()]);
+    entry.size = at - input - entry.offset + 1;
+    entry.next = entries.size();
+    containers.pop_back();
+    return true;
+  }
+
+  inline void Parser::Recorder::onNull(const char *at) {
+    add(GlideJson::Null, at - 3, 4, 0);
+  }
+
+  inline void Parser::Recorder::onBoolean(bool input, const char *at) {
+    if(input) {
+      add(GlideJson::Boolean, at - 3, 4, 1);
+    }
+    else {
+      add(GlideJson::Boolean, at - 4, 5, 0);
+    }
+  }
+
+  inline bool Parser::Recorder::onNumber(unsigned char state, const char *at) {
+    (void)state;
+    number = entries.size();
+    numberPending = true;
+    add(GlideJson::Number, at, 1, 0);
+    return true;
+  }
+
+  inline void Parser::Recorder::onNumberEnd(const char *at) {
+    if(numberPending) {
+      entries[number].size = at - input - entries[number].offset;
+      numberPending = false;
+    }
+  }
+
+  inline bool Parser::Recorder::onString(const char *at, const char *end) {
+    (void)end;
+    add(GlideJson::String, at + 1, 0, 0);
+    return true;
+  }
+
+  inline bool Parser::Recorder::onStringEnd(const char *at) {
+    entries.back().size = at - input - entries.back().offset;
+    return Actions::onStringEnd(at);
+  }
+
+  // The string is decoded only if it's ever accessed:
+  inline bool Parser::Recorder::onEscape(const char *at) {
+    (void)at;
+    entries.back().flag = 1;
+    return true;
+  }
+
+  inline bool Parser::Recorder::onArray(const char *at) {
+    open(GlideJson::Array, at);
+    return true;
+  }
+
+  inline void Parser::Recorder::onEmptyArray(const char *at) {
+    close(GlideJson::Array, at);
+  }
+
+  inline bool Parser::Recorder::onArrayEnd(const char *at) {
+    onNumberEnd(at);
+    return close(GlideJson::Array, at);
+  }
+
+  inline bool Parser::Recorder::onComma(const char *at, unsigned char &state) {
+    onNumberEnd(at);
+    if(containers.empty() || ((entries[containers.back()].type == GlideJson::Object) & (key != 0))) {
+      return false;
+    }
+    if(entries[containers.back()].type == GlideJson::Object) {
+      state = 64;
+      key = 1;
+    }
+    return true;
+  }
+
+  inline bool Parser::Recorder::onObject(const char *at) {
+    open(GlideJson::Object, at);
+    return true;
+  }
+
+  // The key expected after '{' never came:
+  inline void Parser::Recorder::onEmptyObject(const char *at) {
+    key = 0;
+    close(GlideJson::Object, at);
+  }
+
+  inline bool Parser::Recorder::onObjectEnd(const char *at) {
+    onNumberEnd(at);
+    return close(GlideJson::Object, at);
+  }
+
+  GlideJson Parser::parse(const std::string &input, GlideJsonTape &tape) {
+    return Parser::parse(input.data(), input.size(), tape);
+  }
+
+  GlideJson Parser::parse(const char *cInput, size_t size, GlideJsonTape &tape) {
+    static const ParserInitializer &parserInitializer(ParserInitializer::initializer());
+    (void)parserInitializer;
+    //
+    unsigned char state(size > 0);
+    unsigned short unicode(0);
+    Recorder recorder(tape, cInput);
+    size_t finalIndex(Parser::scan(recorder, cInput, size, state, unicode));
+    GlideJson output;
+    if(incompleteMap[state] || !recorder.finish(cInput + size)) {
+      tape.tape.clear();
+      output = GlideJson::Error;
+      ((GlideJsonScheme::Error *)(output.content))->error = "Parsing failed at index " + std::to_string(finalIndex) + "!";
+    }
+    return output;
+  }
+
+  // ========================================
+
+  /*
+    Only what decides validity is kept. Values are skipped instead of
+    decoded, and the nesting is a stack of bits, true for objects.
+  */
+  Parser::Checker::Checker() : Actions(), containers() {
+  }
+
+  Parser::Checker::~Checker() {
+  }
+
+  bool Parser::Checker::finish() const {
+    return containers.empty();
+  }
+
+  inline bool Parser::Checker::onArray(const char *at) {
+    (void)at;
+    containers.push_back(false);
+    return true;
+  }
+
+  inline void Parser::Checker::onEmptyArray(const char *at) {
+    (void)at;
+    containers.pop_back();
+  }
+
+  inline bool Parser::Checker::onArrayEnd(const char *at) {
+    (void)at;
+    if(containers.empty() || containers.back()) {
+      return false;
+    }
+    containers.pop_back();
+    return true;
+  }
+
+  inline bool Parser::Checker::onComma(const char *at, unsigned char &state) {
+    (void)at;
+    if(containers.empty() || (containers.back() & (key != 0))) {
+      return false;
+    }
+    if(containers.back()) {
+      state = 64;
+      key = 1;
+    }
+    return true;
+  }
+
+  inline bool Parser::Checker::onObject(const char *at) {
+    (void)at;
+    containers.push_back(true);
+    key = 1;
+    return true;
+  }
+
+  inline void Parser::Checker::onEmptyObject(const char *at) {
+    (void)at;
+    containers.pop_back();
+    key = 0;
+  }
+
+  inline bool Parser::Checker::onObjectEnd(const char *at) {
+    (void)at;
+    if(containers.empty() || !containers.back() || key) {
+      return false;
+    }
+    containers.pop_back();
+    return true;
+  }
+
+  bool Parser::validate(const std::string &input, size_t &index) {
+    return Parser::validate(input.data(), input.size(), index);
+  }
+
+  bool Parser::validate(const char *cInput, size_t size, size_t &index) {
+    static const ParserInitializer &parserInitializer(ParserInitializer::initializer());
+    (void)parserInitializer;
+    //
+    unsigned char state(size > 0);
+    unsigned short unicode(0);
+    Checker checker;
+    size_t finalIndex(Parser::scan(checker, cInput, size, state, unicode));
+    if(incompleteMap[state] || !checker.finish()) {
+      index = finalIndex;
+      return false;
+    }
+    return true;
+  }
+
+  // ========================================
+
+  // Drops "from" and every member after it:
+  void Parser::truncate(GlideHashMap<GlideJson> &object, const ObjectIterator &from) {
+    std::vector<std::string> keys;
+    ObjectIterator i(from);
+    ObjectIterator iEnd(object.end());
+    while(i != iEnd) {
+      keys.push_back(i.key());
+      i.next();
+    }
+    size_t j(0);
+    while(j < keys.size()) {
+      object.erase(keys[j]);
+      ++j;
+    }
+  }
+
+  /*
+    The target is overwritten in place rather than built from scratch. A
+    value only gets a new node when its type changes, so containers keep
+    their vectors and maps, and strings and numbers keep their buffers:
+
+    - Array elements are reused by position. "positions" holds the
+      position being filled, and whatever is left past it is dropped when
+      the array ends.
+    - Object members are reused as long as the keys arrive in the same
+      order as they are stored. "iterators" holds the next member to
+      compare with. On the first mismatch, that member and everything
+      after it are dropped, and the rest of the keys are inserted as
+      usual, so the order always ends up being that of the input.
+
+    Keys are decoded into "keyString" so that matching ones aren't copied
+    at all. The stacks and "keyString" are kept per thread by "parseInto"
+    so that re-parsing a document of the same shape allocates nothing.
+  */
+  Parser::Rebuilder::Rebuilder(GlideJson &target, std::vector<GlideJson *> &containers, std::vector<size_t> &positions, std::vector<ObjectIterator> &iterators, std::string &keyString) : Actions(), containers(containers), positions(positions), iterators(iterators), keyString(keyString), cOutput(&target), decoded(NULL), decodedSize(0), decodedCapacity(0) {
+    containers.clear();
+    positions.clear();
+    iterators.clear();
+  }
+
+  Parser::Rebuilder::~Rebuilder() {
+  }
+
+  bool Parser::Rebuilder::finish() {
+    if(!containers.empty()) {
+      return false;
+    }
+    settle();
+    return true;
+  }
+
+  // Values are decoded straight into their own buffers, at their old capacity:
+  inline void Parser::Rebuilder::begin(std::string &input) {
+    decoded = &input;
+    decodedCapacity = decoded->capacity();
+    if(decodedCapacity < GlideString::initialCapacity) {
+      decodedCapacity = GlideString::initialCapacity;
+    }
+    decoded->resize(decodedCapacity);
+    decodedSize = 0;
+  }
+
+  inline void Parser::Rebuilder::settle() {
+    if(decoded) {
+      decoded->resize(decodedSize);
+      decoded = NULL;
+    }
+  }
+
+  inline void Parser::Rebuilder::pop() {
+    containers.pop_back();
+    positions.pop_back();
+    iterators.pop_back();
+  }
+
+  inline void Parser::Rebuilder::onNull(const char *at) {
+    (void)at;
+    if(cOutput->content->getType() != GlideJson::Null) {
+      *cOutput = GlideJson::Null;
+    }
+  }
+
+  inline void Parser::Rebuilder::onBoolean(bool input, const char *at) {
+    (void)at;
+    if(cOutput->content->getType() != GlideJson::Boolean) {
+      *cOutput = GlideJson::Boolean;
+    }
+    ((Boolean *)(cOutput->content))->boolean = input;
+  }
+
+  inline bool Parser::Rebuilder::onNumber(unsigned char state, const char *at) {
+    settle();
+    if(cOutput->content->getType() != GlideJson::Number) {
+      *cOutput = GlideJson::Number;
+    }
+    Number &number(*((Number *)(cOutput->content)));
+    begin(number.number);
+    (*decoded)[0] = *at;
+    decodedSize = 1;
+    number.clear();
+    number.negative = (state == 17);
+    number.mantissa = (state == 16) ? (*at - '0') : 0;
+    return true;
+  }
+
+  inline bool Parser::Rebuilder::onNumberByte(unsigned char state, unsigned char input) {
+    GlideString::append(input, decodedSize, decodedCapacity, *decoded);
+    if(state == 24) {
+      ((Number *)(cOutput->content))->negativeExponent = (input == '-');
+    }
+    return true;
+  }
+
+  inline bool Parser::Rebuilder::onDigits(unsigned char state, const char *at, size_t size) {
+    GlideString::append(at, size, decodedSize, decodedCapacity, *decoded);
+    if(state == 23) {
+      ((Number *)(cOutput->content))->exponentDigits(at, size);
+    }
+    else {
+      ((Number *)(cOutput->content))->digits(at, size, state == 21);
+    }
+    return true;
+  }
+
+  inline bool Parser::Rebuilder::onString(const char *at, const char *end) {
+    settle();
+    if(key == 1) {
+      begin(keyString);
+    }
+    else {
+      // A StringView is a String too, but it has no buffer of its own:
+      if(!dynamic_cast<String *>(cOutput->content)) {
+        *cOutput = GlideJson::String;
+      }
+      begin(((String *)(cOutput->content))->string);
+    }
+    GlideString::append(at + 1, end - at - 1, decodedSize, decodedCapacity, *decoded);
+    return true;
+  }
+
+  inline bool Parser::Rebuilder::onVerbatim(const char *at, size_t size) {
+    GlideString::append(at, size, decodedSize, decodedCapacity, *decoded);
+    return true;
+  }
+
+  inline void Parser::Rebuilder::onDecoded(unsigned char input) {
+    GlideString::append(input, decodedSize, decodedCapacity, *decoded);
+  }
+
+  inline bool Parser::Rebuilder::onMultibyte(unsigned char input) {
+    GlideString::append(input, decodedSize, decodedCapacity, *decoded);
+    return true;
+  }
+
+  inline bool Parser::Rebuilder::onArray(const char *at) {
+    (void)at;
+    if(cOutput->content->getType() != GlideJson::Array) {
+      *cOutput = GlideJson::Array;
+    }
+    containers.push_back(cOutput);
+    positions.push_back(0);
+    iterators.push_back(ObjectIterator());
+    std::vector<GlideJson> &array(((Array *)(cOutput->content))->theArray());
+    if(array.empty()) {
+      array.push_back(GlideJson());
+    }
+    cOutput = &(array.front());
+    return true;
+  }
+
+  inline void Parser::Rebuilder::onEmptyArray(const char *at) {
+    (void)at;
+    cOutput = containers.back();
+    ((Array *)(cOutput->content))->array.clear();
+    pop();
+  }
+
+  inline bool Parser::Rebuilder::onArrayEnd(const char *at) {
+    (void)at;
+    settle();
+    if(containers.empty() || (containers.back()->content->getType() != GlideJson::Array)) {
+      return false;
+    }
+    cOutput = containers.back();
+    ((Array *)(cOutput->content))->array.resize(positions.back() + 1);
+    pop();
+    return true;
+  }
+
+  inline bool Parser::Rebuilder::onComma(const char *at, unsigned char &state) {
+    (void)at;
+    settle();
+    if(containers.empty() || ((containers.back()->content->getType() == GlideJson::Object) & (key != 0))) {
+      return false;
+    }
+    if(containers.back()->content->getType() == GlideJson::Object) {
+      state = 64;
+      key = 1;
+      return true;
+    }
+    std::vector<GlideJson> &array(((Array *)(containers.back()->content))->array);
+    size_t position(++(positions.back()));
+    if(position == array.size()) {
+      array.push_back(GlideJson());
+    }
+    cOutput = &(array[position]);
+    return true;
+  }
+
+  inline bool Parser::Rebuilder::onObject(const char *at) {
+    (void)at;
+    if(cOutput->content->getType() != GlideJson::Object) {
+      *cOutput = GlideJson::Object;
+    }
+    containers.push_back(cOutput);
+    positions.push_back(0);
+    iterators.push_back(((Object *)(cOutput->content))->theObject().begin());
+    key = 1;
+    return true;
+  }
+
+  inline void Parser::Rebuilder::onEmptyObject(const char *at) {
+    (void)at;
+    ((Object *)(containers.back()->content))->object.clear();
+    pop();
+    key = 0;
+  }
+
+  inline bool Parser::Rebuilder::onObjectEnd(const char *at) {
+    (void)at;
+    settle();
+    if(containers.empty() || (containers.back()->content->getType() != GlideJson::Object) || key) {
+      return false;
+    }
+    cOutput = containers.back();
+    Parser::truncate(((Object *)(cOutput->content))->object, iterators.back());
+    pop();
+    return true;
+  }
+
+  inline bool Parser::Rebuilder::onColon() {
+    if(!Actions::onColon()) {
+      return false;
+    }
+    keyString.resize(decodedSize);
+    decoded = NULL;
+    GlideHashMap<GlideJson> &object(((Object *)(containers.back()->content))->object);
+    ObjectIterator &iterator(iterators.back());
+    if((iterator != object.end()) && (iterator.key() == keyString)) {
+      cOutput = &(iterator.value());
+      iterator.next();
+    }
+    else {
+      Parser::truncate(object, iterator);
+      cOutput = &(object[keyString]);
+      iterator = object.end();
+    }
+    return true;
+  }
+
+  bool Parser::parseInto(GlideJson &target, const std::string &input) {
+    return Parser::parseInto(target, input.data(), input.size());
+  }
+
+  bool Parser::parseInto(GlideJson &target, const char *cInput, size_t size) {
+    static const ParserInitializer &parserInitializer(ParserInitializer::initializer());
+    static thread_local std::vector<GlideJson *> containers;
+    static thread_local std::vector<size_t> positions;
+    static thread_local std::vector<ObjectIterator> iterators;
+    static thread_local std::string keyString;
+    (void)parserInitializer;
+    //
+    unsigned char state(size > 0);
+    unsigned short unicode(0);
+    Rebuilder rebuilder(target, containers, positions, iterators, keyString);
+    size_t finalIndex(Parser::scan(rebuilder, cInput, size, state, unicode));
+    if(incompleteMap[state] || !rebuilder.finish()) {
+      target = GlideJson::Error;
+      ((GlideJsonScheme::Error *)(target.content))->error = "Parsing failed at index " + std::to_string(finalIndex) + "!";
+      return false;
+    }
+    return true;
+  }
+
+  /*
+    A parser that never received a single byte is still at state 1,
+    which is incomplete: nothing is represented by an empty string in
+    JSON. The error refers to the failing byte if there is one, and to
+    the end of the input otherwise.
+  */
+  GlideJson Parser::finish(GlideJsonParser &parser) {
+    static const ParserInitializer &parserInitializer(ParserInitializer::initializer());
+    (void)parserInitializer;
+    //
+    if(parser.decoded) {
+      parser.decoded->assign(parser.scratch.data(), parser.decodedSize);
+    }
+    static const char *failures[] = {"Parsing failed", "Maximum depth exceeded", "Maximum length exceeded", "Maximum node count exceeded", "Maximum byte budget exceeded"};
+    GlideJson output(std::move(parser.output));
+    if(incompleteMap[parser.state] | (parser.containers.size() != 1)) {
+      output = GlideJson::Error;
+      ((GlideJsonScheme::Error *)(output.content))->error = failures[parser.state ? 0 : parser.exceeded] + (" at index " + std::to_string(parser.state ? parser.offset : parser.finalIndex) + "!");
+    }
+    parser.reset();
+    return output;
+  }
+
+  /*
+    Every thread keeps a GlideJsonParser of its own, so the container
+    stack and the scratch buffer outlive each call. It's reset on the way
+    in as well as by "finish", since an exception thrown out of "feed"
+    would otherwise leave a half-finished parse behind for the next call.
+  */
+  GlideJsonParser & Parser::threadParser() {
+    static thread_local GlideJsonParser parser;
+    parser.reset();
+    return parser;
+  }
+
+  GlideJson Parser::parse(const std::string &input) {
+    GlideJsonParser &parser(Parser::threadParser());
+    Parser::feed(parser, input);
+    return Parser::finish(parser);
+  }
+
+  GlideJson Parser::parse(const char *cInput, size_t size) {
+    GlideJsonParser &parser(Parser::threadParser());
+    Parser::feed(parser, cInput, size);
+    return Parser::finish(parser);
+  }
+
+  // "owner" keeps the input alive for as long as any string refers to it:
+  GlideJson Parser::parse(const std::shared_ptr<const void> &owner, const char *cInput, size_t size) {
+    GlideJsonParser &parser(Parser::threadParser());
+    Parser::feed(parser, owner, cInput, size);
+    return Parser::finish(parser);
+  }
+
+  /*
+    The limits only hold for this call, the thread's parser has none
+    otherwise. "reset" leaves them alone, so they're cleared on the way
+    out even if "feed" or "finish" throws.
+  */
+  GlideJson Parser::parse(const char *cInput, size_t size, const GlideJsonLimits &limits) {
+    struct Restore {
+      GlideJsonParser &parser;
+      ~Restore() {
+        parser.limits = GlideJsonLimits();
+      }
+    };
+    GlideJsonParser &parser(Parser::threadParser());
+    Restore restore = {parser};
+    parser.limits = limits;
+    Parser::feed(parser, cInput, size);
+    return Parser::finish(parser);
+  }
+
+  GlideJson Parser::parseFile(const std::string &path) {
+    MappedFile file;
+    if(!file.open(path)) {
+      GlideJson output(GlideJson::Error);
+      ((GlideJsonScheme::Error *)(output.content))->error = "Reading " + path + " failed!";
+      return output;
+    }
+    return Parser::parse(file.data, file.size);
+  }
+
+  // The mapping lives as long as any string that still refers to it:
+  GlideJson Parser::parseFileShared(const std::string &path) {
+    std::shared_ptr<MappedFile> file(std::make_shared<MappedFile>());
+    if(!file->open(path)) {
+      GlideJson output(GlideJson::Error);
+      ((GlideJsonScheme::Error *)(output.content))->error = "Reading " + path + " failed!";
+      return output;
+    }
+    return Parser::parse(file, file->data, file->size);
+  }
+
+  GlideJson Parser::parse(const char *cInput, size_t size, const GlideJsonSelector &selector) {
+    Selection selection(selector);
+    GlideJson output(Parser::parse(cInput, size, (GlideJsonHandler &)selection));
+    if(output.getType() == GlideJson::Error) {
+      return output;
+    }
+    return std::move(selection.output);
+  }
+
+  /*
+    Finds where to cut the top-level container that opens at "begin" so
+    that its elements can be parsed on separate threads. "cuts" starts
+    with "begin", continues with a separating comma about every "share"
+    bytes, and ends with the closing bracket. Strings are skipped without
+    being checked, since every byte between the cuts still goes through
+    "Parser::parse" afterwards. Returns false if the brackets don't add up
+    or anything but whitespace follows, in which case the whole input is
+    better left to "Parser::parse" for its error.
+  */
+  bool Parser::split(const char *cInput, size_t size, size_t begin, size_t share, std::vector<size_t> &cuts) {
+    size_t depth(1);
+    size_t i(begin + 1);
+    cuts.assign(1, begin);
+    while((i = GlideScan::structural(cInput, i, size)) < size) {
+      switch(cInput[i]) {
+        case '"':
+          ++i;
+          while((i = GlideScan::verbatim(cInput, i, size)) < size) {
+            if(cInput[i] == '"') {
+              break;
+            }
+            i += (cInput[i] == '\\') ? 2 : 1;
+          }
+          if(i >= size) {
+            return false;
+          }
+          break;
+        case ',':
+          if((depth == 1) && (i - cuts.back() > share)) {
+            cuts.push_back(i);
+          }
+          break;
+        case '[':
+        case '{':
+          ++depth;
+          break;
+        case ']':
+        case '}':
+          if(!--depth) {
+            cuts.push_back(i);
+            return (cInput[i] == cInput[begin] + 2) && (GlideScan::whitespace(cInput, i + 1, size) == size);
+          }
+          break;
+        default:
+          // A control character folded onto '"' or ',':
+          return false;
+      }
+      ++i;
+    }
+    return false;
+  }
+
+  /*
+    Each run of elements between two cuts is parsed as a container of its
+    own on whichever worker claims it. Meanwhile, the calling thread
+    splices the parts back together in order, each one as soon as it's
+    ready. Building the index of a huge object can only happen on one
+    thread, but this way it overlaps the parsing of later parts, and only
+    the last part is spliced after everything is parsed. Duplicate keys
+    across parts end up the same way they do in a sequential parse: the
+    first position, the last value. Any part failing means the input is
+    invalid somewhere, and the sequential parse reports exactly where.
+  */
+  #define GLIDE_JSON_PARALLEL_MINIMUM ((size_t)1 << 20)
+  #define GLIDE_JSON_PARALLEL_SHARES 4
+
+  GlideJson Parser::parseInParallel(const char *cInput, size_t size, size_t threads) {
+    if(!threads) {
+      threads = std::thread::hardware_concurrency();
+    }
+    std::vector<size_t> cuts;
+    size_t begin(GlideScan::whitespace(cInput, 0, size));
+    if(
+      (threads < 2) || (size < GLIDE_JSON_PARALLEL_MINIMUM) || (begin == size)
+      || ((cInput[begin] != '[') && (cInput[begin] != '{'))
+      || !Parser::split(cInput, size, begin, size / (threads * GLIDE_JSON_PARALLEL_SHARES), cuts)
+    ) {
+      return Parser::parse(cInput, size);
+    }
+    size_t parts(cuts.size() - 1);
+    std::vector<GlideJson> output(parts);
+    std::vector<unsigned char> done(parts, 0);
+    std::mutex lock;
+    std::condition_variable ready;
+    std::atomic<size_t> next(0);
+    std::atomic<bool> failed(false);
+    auto work([&]() {
+      std::string buffer;
+      size_t i;
+      bool bad;
+      try {
+        while(((i = next.fetch_add(1)) < parts) && !failed) {
+          buffer.assign(1, cInput[begin]);
+          buffer.append(cInput + cuts[i] + 1, cuts[i + 1] - cuts[i] - 1);
+          buffer.push_back(cInput[begin] + 2);
+          output[i] = Parser::parse(buffer);
+          // Only an empty container may have an empty part, as "[1, ,2]" shows:
+          bad = (output[i].getType() == GlideJson::Error)
+            || ((parts > 1) && ((output[i].getType() == GlideJson::Array) ? output[i].array().empty() : output[i].object().empty()));
+          std::lock_guard<std::mutex> guard(lock);
+          done[i] = 1;
+          if(bad) {
+            failed = true;
+          }
+          ready.notify_all();
+        }
+      }
+      catch(...) {
+        // The splicing below must not wait for a part that never comes:
+        std::lock_guard<std::mutex> guard(lock);
+        failed = true;
+        ready.notify_all();
+        throw;
+      }
+    });
+    // Without a single other thread, splitting only costs time:
+    Workers pool(std::min(threads, parts), work);
+    if(!pool.size()) {
+      return Parser::parse(cInput, size);
+    }
+    GlideJson spliced;
+    size_t i(0);
+    while(i < parts) {
+      {
+        std::unique_lock<std::mutex> guard(lock);
+        while(!done[i] && !failed) {
+          ready.wait(guard);
+        }
+      }
+      if(failed) {
+        break;
+      }
+      if(!i) {
+        spliced = std::move(output[0]);
+      }
+      else if(spliced.getType() == GlideJson::Array) {
+        std::vector<GlideJson> &array(spliced.array());
+        array.insert(array.end(), std::make_move_iterator(output[i].array().begin()), std::make_move_iterator(output[i].array().end()));
+      }
+      else {
+        spliced.object().splice(output[i].object());
+      }
+      output[i] = GlideJson();
+      ++i;
     }
-    while(++i <= 'F');
-    i = 'a';
-    do {
-      stateMap[i + GLIDE_BYTE_SIZE * 38] = 40;
-      stateMap[i + GLIDE_BYTE_SIZE * 42] = 43;
+    pool.join();
+    if(failed) {
+      return Parser::parse(cInput, size);
     }
-    while(++i <= 'f');
-    /*
-      Finally, make sure the JSON string is valid UTF-8 by mapping the
-      sequences in the remainder of the unicode range. We already took care
-      of control characters and one-byte sequences above. These remaining
-      branches are for 2 to 4 bytes.
+    return spliced;
+  }
 
-      Note that state 52 terminates all valid byte sequences then leads to
-      state 26. See "copyTransitions" below.
+  #undef GLIDE_JSON_PARALLEL_SHARES
+  #undef GLIDE_JSON_PARALLEL_MINIMUM
 
-      Grammar for UTF-8 from RFC 3629:
+  /*
+    Only the boundaries of the top-level elements are tracked here, the
+    same way "split" does: the nesting depth, and whether the current byte
+    is inside a string. Both survive the end of a buffer. Every byte of an
+    element goes through "feed" as soon as it's read, which validates it,
+    so an element never has to fit in the buffer. "parser.offset" starts
+    at the element, so its errors refer to the whole input.
+  */
+  bool Parser::next(GlideJsonArrayReader &reader, GlideJson &output) {
+    const char *cInput;
+    size_t begin;
+    size_t i;
+    bool boundary;
+    while(reader.stage != GlideJsonArrayReader::Done) {
+      if((reader.position == reader.filled) && !reader.fill()) {
+        reader.parser.reset();
+        if(!reader.unreadable && (reader.stage == GlideJsonArrayReader::Closed)) {
+          reader.stage = GlideJsonArrayReader::Done;
+          return false;
+        }
+        reader.stage = GlideJsonArrayReader::Done;
+        output = GlideJson::Error;
+        ((GlideJsonScheme::Error *)(output.content))->error = (reader.unreadable ? "Reading failed at index " : "Parsing failed at index ") + std::to_string(reader.offset) + "!";
+        return true;
+      }
+      cInput = reader.buffer.data();
+      i = reader.position;
+      switch(reader.stage) {
+        case GlideJsonArrayReader::First:
+          // Like "parse", only a ']' right after the '[' makes an empty array:
+          if(cInput[i] == ']') {
+            reader.stage = GlideJsonArrayReader::Closed;
+            ++i;
+          }
+          else {
+            reader.stage = GlideJsonArrayReader::Element;
+            reader.parser.offset = reader.offset + i;
+          }
+          break;
+        case GlideJsonArrayReader::Opening:
+        case GlideJsonArrayReader::Closed:
+          i = GlideScan::whitespace(cInput, i, reader.filled);
+          if(i == reader.filled) {
+            break;
+          }
+          if((reader.stage == GlideJsonArrayReader::Opening) && (cInput[i] == '[')) {
+            reader.stage = GlideJsonArrayReader::First;
+            ++i;
+          }
+          else {
+            reader.stage = GlideJsonArrayReader::Done;
+            output = GlideJson::Error;
+            ((GlideJsonScheme::Error *)(output.content))->error = "Parsing failed at index " + std::to_string(reader.offset + i) + "!";
+            return true;
+          }
+          break;
+        case GlideJsonArrayReader::Element:
+          begin = i;
+          boundary = false;
+          while(!boundary && (i < reader.filled)) {
+            if(reader.escaped) {
+              reader.escaped = false;
+              ++i;
+            }
+            else if(reader.quoted) {
+              i = GlideScan::verbatim(cInput, i, reader.filled);
+              if(i < reader.filled) {
+                reader.quoted = (cInput[i] != '"');
+                reader.escaped = (cInput[i] == '\\');
+                ++i;
+              }
+            }
+            else if((i = GlideScan::structural(cInput, i, reader.filled)) < reader.filled) {
+              switch(cInput[i]) {
+                case '"':
+                  reader.quoted = true;
+                  break;
+                case ',':
+                  boundary = !reader.depth;
+                  break;
+                case '[':
+                case '{':
+                  ++reader.depth;
+                  break;
+                case ']':
+                  boundary = !reader.depth;
+                  if(reader.depth) {
+                    --reader.depth;
+                  }
+                  break;
+                case '}':
+                  // Unbalanced, so "feed" fails on it:
+                  if(reader.depth) {
+                    --reader.depth;
+                  }
+                  break;
+                default:
+                  // A control character folded onto '"' or ',':
+                  break;
+              }
+              i += !boundary;
+            }
+          }
+          if(!Parser::feed(reader.parser, cInput + begin, i - begin)) {
+            reader.stage = GlideJsonArrayReader::Done;
+            output = Parser::finish(reader.parser);
+            return true;
+          }
+          if(boundary) {
+            output = Parser::finish(reader.parser);
+            if(output.getType() == GlideJson::Error) {
+              reader.stage = GlideJsonArrayReader::Done;
+              return true;
+            }
+            if(cInput[i] == ',') {
+              reader.parser.offset = reader.offset + i + 1;
+            }
+            else {
+              reader.stage = GlideJsonArrayReader::Closed;
+            }
+            reader.position = i + 1;
+            return true;
+          }
+          break;
+        default:
+          break;
+      }
+      reader.position = i;
+    }
+    return false;
+  }
 
-      UTF8-octets = *( UTF8-char )
-      UTF8-char   = UTF8-1 / UTF8-2 / UTF8-3 / UTF8-4
-      UTF8-1      = %x00-7F
-      UTF8-2      = %xC2-DF UTF8-tail
-      UTF8-3      = %xE0 %xA0-BF UTF8-tail /
-                    %xE1-EC 2( UTF8-tail ) /
-                    %xED %x80-9F UTF8-tail /
-                    %xEE-EF 2( UTF8-tail )
-      UTF8-4      = %xF0 %x90-BF 2( UTF8-tail ) /
-                    %xF1-F3 3( UTF8-tail ) /
-                    %xF4 %x80-8F 2( UTF8-tail )
-      UTF8-tail   = %x80-BF
-    */
-    // UTF8-2      = %xC2-DF UTF8-tail
-    i = 194;
-    do {
-      stateMap[i + GLIDE_BYTE_SIZE * 26] = 49;
+  // ========================================
+
+  /*
+    Builds the parts of the document picked by a GlideJsonSelector out of
+    the events of "Parser::parse". Each container on the way to a selected
+    value is built, along with the set of selector nodes that apply to its
+    children (more than one when a wildcard and a key overlap). These sets
+    are stored back to back in "nodes", starting at "starts". A set holding
+    only GLIDE_JSON_SELECTED means the whole container is selected.
+
+    Anything else is only counted in "skipped" until it ends. Elements of a
+    container on the way are kept as null, so arrays keep their positions.
+  */
+  #define GLIDE_JSON_SELECTED ((size_t)-1)
+
+  Selection::Selection(const GlideJsonSelector &selector) : GlideJsonHandler(), selector(selector), containers(), starts(), counts(), nodes(), candidates(), skipped(0), key(), output() {
+  }
+
+  Selection::Selection(const Selection &input) : GlideJsonHandler(), selector(input.selector) {
+    (void)input;
+    throw GlideError("GlideJsonScheme::Selection::Selection(const Selection &input): No copy constructor!");
+  }
+
+  Selection::~Selection() {
+  }
+
+  Selection & Selection::operator=(const Selection &input) {
+    (void)input;
+    throw GlideError("GlideJsonScheme::Selection::operator=(const Selection &input): No assignment operator!");
+    return *this;
+  }
+
+  bool Selection::select() {
+    candidates.clear();
+    if(containers.empty()) {
+      candidates.push_back(0);
     }
-    while(++i <= 223);
-    i = 128;
-    do {
-      stateMap[i + GLIDE_BYTE_SIZE * 49] = 52;
+    else {
+      size_t i(starts.back());
+      size_t end(nodes.size());
+      bool array(containers.back()->getType() == GlideJson::Array);
+      if(array) {
+        containers.back()->array().push_back(GlideJson());
+      }
+      if(nodes[i] == GLIDE_JSON_SELECTED) {
+        candidates.push_back(GLIDE_JSON_SELECTED);
+        return true;
+      }
+      if(array) {
+        key = std::to_string(counts.back()++);
+      }
+      while(i < end) {
+        const SelectorNode &parent(selector.nodes[nodes[i]]);
+        auto found(parent.children.find(key));
+        if(found != parent.children.end()) {
+          candidates.push_back(found->second);
+        }
+        if(parent.wildcard) {
+          candidates.push_back(parent.wildcard);
+        }
+        ++i;
+      }
     }
-    while(++i <= 191);
-    /*
-      UTF8-3      = %xE0 %xA0-BF UTF8-tail /
-                    %xE1-EC 2( UTF8-tail ) /
-                    %xED %x80-9F UTF8-tail /
-                    %xEE-EF 2( UTF8-tail )
-    */
-    stateMap[224 + GLIDE_BYTE_SIZE * 26] = 53;
-    i = 160;
-    do {
-      stateMap[i + GLIDE_BYTE_SIZE * 53] = 49;
+    size_t i(0);
+    size_t size(candidates.size());
+    while(i < size) {
+      if(selector.nodes[candidates[i]].selected) {
+        candidates.assign(1, GLIDE_JSON_SELECTED);
+        return true;
+      }
+      ++i;
     }
-    while(++i <= 191);
-    //
-    i = 225;
-    do {
-      stateMap[i + GLIDE_BYTE_SIZE * 26] = 50;
+    return size;
+  }
+
+  GlideJson & Selection::slot() {
+    if(containers.empty()) {
+      return output;
     }
-    while(++i <= 236);
-    stateMap[238 + GLIDE_BYTE_SIZE * 26] = 50;
-    stateMap[239 + GLIDE_BYTE_SIZE * 26] = 50;
-    i = 128;
-    do {
-      stateMap[i + GLIDE_BYTE_SIZE * 50] = 49;
+    if(containers.back()->getType() == GlideJson::Array) {
+      return containers.back()->array().back();
     }
-    while(++i <= 191);
-    //
-    stateMap[237 + GLIDE_BYTE_SIZE * 26] = 54;
-    i = 128;
-    do {
-      stateMap[i + GLIDE_BYTE_SIZE * 54] = 49;
+    return containers.back()->object()[key];
+  }
+
+  void Selection::start(GlideJson::Type type) {
+    if(skipped) {
+      ++skipped;
     }
-    while(++i <= 159);
-    /*
-      UTF8-4      = %xF0 %x90-BF 2( UTF8-tail ) /
-                    %xF1-F3 3( UTF8-tail ) /
-                    %xF4 %x80-8F 2( UTF8-tail )
-    */
-    stateMap[240 + GLIDE_BYTE_SIZE * 26] = 55;
-    i = 144;
-    do {
-      stateMap[i + GLIDE_BYTE_SIZE * 55] = 50;
+    else if(select()) {
+      GlideJson &container(slot());
+      container = type;
+      containers.push_back(&container);
+      starts.push_back(nodes.size());
+      counts.push_back(0);
+      nodes.insert(nodes.end(), candidates.begin(), candidates.end());
     }
-    while(++i <= 191);
-    //
-    stateMap[241 + GLIDE_BYTE_SIZE * 26] = 51;
-    stateMap[242 + GLIDE_BYTE_SIZE * 26] = 51;
-    stateMap[243 + GLIDE_BYTE_SIZE * 26] = 51;
-    i = 128;
-    do {
-      stateMap[i + GLIDE_BYTE_SIZE * 51] = 50;
+    else {
+      skipped = 1;
     }
-    while(++i <= 191);
-    //
-    stateMap[244 + GLIDE_BYTE_SIZE * 26] = 56;
-    i = 128;
-    do {
-      stateMap[i + GLIDE_BYTE_SIZE * 56] = 50;
+  }
+
+  void Selection::end() {
+    if(skipped) {
+      --skipped;
     }
-    while(++i <= 143);
-    /*
-      As noted above, the following states for parsing JSON strings need to
-      behave exactly the same as state 26. They merely continue string
-      parsing after a special case is handled successfully.
-    */
-    Parser::copyTransitions(26, 25);
-    Parser::copyTransitions(26, 29);
-    Parser::copyTransitions(26, 30);
-    Parser::copyTransitions(26, 31);
-    Parser::copyTransitions(26, 32);
-    Parser::copyTransitions(26, 33);
-    Parser::copyTransitions(26, 34);
-    Parser::copyTransitions(26, 35);
-    Parser::copyTransitions(26, 36);
-    Parser::copyTransitions(26, 46);
-    Parser::copyTransitions(26, 47);
-    Parser::copyTransitions(26, 48);
-    Parser::copyTransitions(26, 52);
-    /*
-      The following changes cover all whitespace scenarios:
-      - Making whitespace at state 1 loop back to state 1 to support
-        whitespace preceding all JSON elements, including most nested ones.
-      - A new state 66 to capture whitespace before a string acting as an
-        object key.
-      - A new state 67 to capture whitespace at the end of valid strings. The
-        separate state is necessary to provide for a colon when the string is
-        acting as an object key.
-      - A new state 68 to capture whitespace at the end of all valid JSON
-        elements except strings.
+    else {
+      containers.pop_back();
+      nodes.resize(starts.back());
+      starts.pop_back();
+      counts.pop_back();
+    }
+  }
 
-      State 1 is defined right here since it must precede any calls to
-      "copyTransitions". The rest of the setup is mixed in with the
-      container definitions to make things a little easier to follow.
-    */
-    Parser::setWhitespace(1, 1);
-    /*
-      First, it's important to note that there is a lot of logic nested in
-      these container states. This is because there exists no FSM that
-      perfectly satisfies the definition of a JSON array or
-      object. Recursive patterns are impossible with FSMs. So, we define a
-      state machine that matches JSON arrays and objects, and use said logic
-      to enforce the recursive patterns.
+  void Selection::onNull() {
+    if(!skipped && select() && (candidates[0] == GLIDE_JSON_SELECTED)) {
+      slot();
+    }
+  }
 
-      The implementation below uses a stack for containers and a placeholder
-      for object keys. States 57, 58, 61, and 62 are hopefully
-      self-explanatory. States 59 and 63 are set as destinations for every
-      final state defined above since they terminate the two
-      containers. These two states can be reached regardless of whether or
-      not the appropriate container has been initialized. This is a symptom
-      of the whole recursive pattern dilemma detailed above. So checks are
-      performed as needed.
+  void Selection::onBoolean(bool input) {
+    if(!skipped && select() && (candidates[0] == GLIDE_JSON_SELECTED)) {
+      slot() = input;
+    }
+  }
 
-      State 60 is for the comma, which is a separator for both JSON arrays
-      and objects. This is the same situation as states 59 and 63, but both
-      a JSON array and a JSON object must be handled here. In the case of a
-      JSON object, the state is edited to 64 to restrict the next element to
-      a string for the key. To enforce alternating keys and values, the
-      object key's placeholder must be null at this point.
+  // The handler FSM has already checked the text, so it's only scanned:
+  void Selection::onNumber(const char *input, size_t size) {
+    if(!skipped && select() && (candidates[0] == GLIDE_JSON_SELECTED)) {
+      GlideJson &number(slot());
+      number = GlideJson::Number;
+      ((Number *)(number.content))->number.assign(input, size);
+      ((Number *)(number.content))->scan(input, size);
+    }
+  }
 
-      State 65 for the colon terminates the object key and begins the
-      corresponding JSON element. The object key placeholder is set to null
-      to indicate that a new key can be parsed at the next comma.
-    */
-    stateMap['[' + GLIDE_BYTE_SIZE] = 57;
-    incompleteMap[58] = false;
-    incompleteMap[59] = false;
-    stateMap['{' + GLIDE_BYTE_SIZE] = 61;
-    stateMap['}' + GLIDE_BYTE_SIZE * 61] = 62;
-    incompleteMap[62] = false;
-    incompleteMap[63] = false;
-    stateMap['"' + GLIDE_BYTE_SIZE * 61] = 25;
-    stateMap['"' + GLIDE_BYTE_SIZE * 64] = 25;
-    stateMap['"' + GLIDE_BYTE_SIZE * 66] = 25;
-    Parser::setWhitespace(61, 66);
-    Parser::setWhitespace(64, 66);
-    Parser::setWhitespace(66, 66);
-    stateMap[':' + GLIDE_BYTE_SIZE * 27] = 65;
-    stateMap[':' + GLIDE_BYTE_SIZE * 67] = 65;
-    Parser::setWhitespace(27, 67);
-    Parser::setWhitespace(67, 67);
-    incompleteMap[67] = false;
-    Parser::copyTransitions(1, 57);
-    stateMap[']' + GLIDE_BYTE_SIZE * 57] = 58;
-    Parser::copyTransitions(1, 60);
-    Parser::copyTransitions(1, 65);
-    incompleteMap[68] = false;
-    i = 0;
-    do {
-      if(!incompleteMap[i]) {
-        stateMap[']' + GLIDE_BYTE_SIZE * i] = 59;
-        stateMap[',' + GLIDE_BYTE_SIZE * i] = 60;
-        stateMap['}' + GLIDE_BYTE_SIZE * i] = 63;
-        if((i != 27) & (i != 67)) {
-          Parser::setWhitespace(i, 68);
-        }
-      }
+  void Selection::onString(const char *input, size_t size) {
+    if(!skipped && select() && (candidates[0] == GLIDE_JSON_SELECTED)) {
+      slot().setString(input, size);
     }
-    while(++i < GLIDE_JSON_PARSER_STATES);
   }
 
-  Parser::Parser() {
-    throw GlideError("GlideJsonScheme::Parser::Parser(): No default constructor!");
+  void Selection::onKey(const char *input, size_t size) {
+    if(!skipped) {
+      key.assign(input, size);
+    }
   }
 
-  Parser::Parser(const Parser &input) {
-    (void)input;
-    throw GlideError("GlideJsonScheme::Parser::Parser(const Parser &input): No copy constructor!");
+  void Selection::onStartArray() {
+    start(GlideJson::Array);
   }
 
-  Parser::~Parser() {
+  void Selection::onEndArray() {
+    end();
   }
 
-  Parser & Parser::operator=(const Parser &input) {
-    (void)input;
-    throw GlideError("GlideJsonScheme::Parser::operator=(const Parser &input): No assignment operator!");
-    return *this;
+  void Selection::onStartObject() {
+    start(GlideJson::Object);
   }
 
-  /*
-    See the source file for comments:
-  */
-  #define GLIDE_JSON_PART_STDSTRING
-  #include "Parser.inc"
-  #undef GLIDE_JSON_PART_STDSTRING
+  void Selection::onEndObject() {
+    end();
+  }
 
-  #define GLIDE_JSON_PART_CSTRING
-  #include "Parser.inc"
-  #undef GLIDE_JSON_PART_CSTRING
+  #undef GLIDE_JSON_SELECTED
 
   // ========================================
 
@@ -2009,4 +6313,9 @@ namespace GlideJsonScheme {
     return *this;
   }
 
+  const ParserInitializer & ParserInitializer::initializer() {
+    static const ParserInitializer initializer;
+    return initializer;
+  }
+
 }
@@ -17,6 +17,74 @@
 
 #include "GlideJsonTest.hpp"
 
+GlideJsonTestHandler::GlideJsonTestHandler() : first(), output() {
+}
+
+GlideJsonTestHandler::~GlideJsonTestHandler() {
+}
+
+// Rebuilds the compact JSON from the events so it can be compared with "toJson":
+void GlideJsonTestHandler::separate() {
+  if(!first.empty()) {
+    if(first.back()) {
+      first.back() = false;
+    }
+    else if(output.back() != ':') {
+      output += ',';
+    }
+  }
+}
+
+void GlideJsonTestHandler::onNull() {
+  separate();
+  output += "null";
+}
+
+void GlideJsonTestHandler::onBoolean(bool input) {
+  separate();
+  output += input ? "true" : "false";
+}
+
+void GlideJsonTestHandler::onNumber(const char *input, size_t size) {
+  separate();
+  output.append(input, size);
+}
+
+void GlideJsonTestHandler::onString(const char *input, size_t size) {
+  separate();
+  output += GlideJson::encodeString(input, size);
+}
+
+void GlideJsonTestHandler::onKey(const char *input, size_t size) {
+  separate();
+  output += GlideJson::encodeString(input, size);
+  output += ':';
+}
+
+void GlideJsonTestHandler::onStartArray() {
+  separate();
+  output += '[';
+  first.push_back(true);
+}
+
+void GlideJsonTestHandler::onEndArray() {
+  output += ']';
+  first.pop_back();
+}
+
+void GlideJsonTestHandler::onStartObject() {
+  separate();
+  output += '{';
+  first.push_back(true);
+}
+
+void GlideJsonTestHandler::onEndObject() {
+  output += '}';
+  first.pop_back();
+}
+
+// ========================================
+
 std::vector<std::string> GlideJsonTest::errors;
 
 std::string GlideJsonTest::hashMapToString(const GlideHashMap<int> &input) {
@@ -62,6 +130,8 @@ int GlideJsonTest::vectorGet(const std::vector< std::pair<std::string, int> > &i
 }
 
 void GlideJsonTest::testGlideHashMap() {
+  // Only the entries of JSON objects keep anything besides the pair:
+  static_assert(sizeof(GlideHashMap<int>::KeyPair) == sizeof(std::pair< GlideSortItem<std::string>, GlideItem<int> >), "GlideHashMap keeps more than the key and value!");
   auto start(std::chrono::steady_clock::now());
   GlideHashMap<int> subject;
   std::vector< std::pair<std::string, int> > checker;
@@ -172,6 +242,24 @@ void GlideJsonTest::testGlideHashMap() {
   if(GlideJsonTest::hashMapToString(subject) != GlideJsonTest::vectorToString(checker)) {
     GlideJsonTest::errors.push_back("Sorting the subject caused it not to be the same as the checker!");
   }
+  // Splicing appends in order, and a key that's already there takes the new value in place:
+  GlideHashMap<int> spliced;
+  GlideHashMap<int> appended;
+  spliced["a"] = 1;
+  spliced["b"] = 2;
+  appended["c"] = 3;
+  appended["a"] = 4;
+  appended["d"] = 5;
+  spliced.splice(appended);
+  spliced.erase("c");
+  spliced["e"] = 6;
+  checker = {{"a", 4}, {"b", 2}, {"d", 5}, {"e", 6}};
+  if(
+    (GlideJsonTest::hashMapToString(spliced) != GlideJsonTest::vectorToString(checker))
+    || (spliced.size() != 4) || (spliced.at("d") != 5) || !appended.empty() || appended.count("c")
+  ) {
+    GlideJsonTest::errors.push_back("Splicing one map onto another went wrong!");
+  }
 }
 
 void GlideJsonTest::escapeByte(const unsigned char &input, std::string &output) {
@@ -1206,9 +1294,1755 @@ void GlideJsonTest::testJsonContainers() {
     }
   }
   while(--i > 0);
+  // An object can't end on a key that was never given a value:
+  const char *keysWithoutValues[] = {"{\"a\"}", "[{\"a\"}]", "{\"a\":1,\"b\"}", "{\"a\":{\"b\"}}"};
+  for(const char *input : keysWithoutValues) {
+    if(GlideJson::parse(input).getType() != GlideJson::Error) {
+      GlideJsonTest::errors.push_back(std::string("The JSON ") + input + " is somehow valid!\n");
+    }
+  }
+  // A repeated key keeps its first position and its last value, null included:
+  if(GlideJson::parse("{\"a\":\"x\",\"b\":1,\"a\":null}").toJson() != "{\"a\":null,\"b\":1}") {
+    GlideJsonTest::errors.push_back("A repeated key did not take its last value!\n");
+  }
   std::cout << "JSON containers test: " << (std::chrono::steady_clock::now() - start).count() << "\n";
 }
 
+/*
+  Runs "input" through every parser that uses the scanners and expects
+  "expected" back from each, or a failure from each if it's empty. The
+  byte after "size" is never part of the input.
+*/
+void GlideJsonTest::checkScanned(const char *input, size_t size, const std::string &expected) {
+  GlideJsonTape tape;
+  GlideJson testJson;
+  std::string testEncoded[4];
+  testJson = GlideJson::parse(input, size);
+  testEncoded[0] = testJson.isError() ? "" : testJson.toJson();
+  testEncoded[1] = GlideJson::parseInto(testJson, input, size) ? testJson.toJson() : "";
+  testEncoded[2] = tape.parse(input, size).isError() ? "" : tape.root().toGlideJson().toJson();
+  testEncoded[3] = GlideJson::validate(input, size) ? expected : "";
+  for(size_t i(0); i < 4; ++i) {
+    if(testEncoded[i] != expected) {
+      GlideJsonTest::errors.push_back("The input:\n\n" + std::string(input, size) + "\n\n... was scanned as:\n\n" + testEncoded[i] + "\n\n... instead of:\n\n" + expected + "\n");
+    }
+  }
+}
+
+/*
+  Places whitespace and digit runs of every length up to a few vector
+  widths at every offset across the first two, including runs that end
+  the input. The input is always followed by bytes that would change the
+  result if the scanners read past its end.
+*/
+void GlideJsonTest::testJsonScanRuns() {
+  const std::string spaces(" \t\n\r");
+  const std::string overrun("55555555555555555555555555555555555555555555555555555555555555555555555555555555x");
+  std::string whitespace;
+  std::string number;
+  std::string input;
+  auto start(std::chrono::steady_clock::now());
+  for(size_t offset(0); offset < 72; ++offset) {
+    number = "1";
+    while(number.size() <= offset) {
+      number += (char)('0' + number.size() % 10);
+    }
+    for(size_t length(0); length < 72; ++length) {
+      whitespace.clear();
+      while(whitespace.size() < length) {
+        whitespace += spaces[(offset + whitespace.size()) % 4];
+      }
+      // Digits from the start, then whitespace up to the end:
+      input = number + whitespace;
+      GlideJsonTest::checkScanned((input + overrun).data(), input.size(), number);
+      // Whitespace from the start, then digits up to the end:
+      input = whitespace + number;
+      GlideJsonTest::checkScanned((input + overrun).data(), input.size(), number);
+      // Both inside a container, and in a fraction and an exponent:
+      input = "[" + number + whitespace + "," + whitespace + "-0." + number + "e+" + number + whitespace + "]";
+      GlideJsonTest::checkScanned(input.data(), input.size(), "[" + number + ",-0." + number + "e+" + number + "]");
+      // A stray byte right where either run ends:
+      input = whitespace + "x" + number;
+      GlideJsonTest::checkScanned(input.data(), input.size(), "");
+      input = whitespace + number + "x" + whitespace;
+      GlideJsonTest::checkScanned(input.data(), input.size(), "");
+    }
+  }
+  std::cout << "JSON scan runs test: " << (std::chrono::steady_clock::now() - start).count() << "\n";
+}
+
+/*
+  Places every kind of byte that ends a verbatim run at every offset below
+  64 of a string, followed by up to 40 verbatim bytes before the closing
+  quote. The same string is also used as a key.
+*/
+void GlideJsonTest::testJsonScanStrings() {
+  const std::string filler("abcdefghijklmnopqrstuvwxyz0123456789 ,:[]{}/");
+  // Each input sequence with its encoding, or nothing if it's invalid:
+  const std::pair<std::string, std::string> specials[] = {
+    {"\\\"", "\\\""},
+    {"\\\\", "\\\\"},
+    {"\\/", "/"},
+    {"\\n", "\\n"},
+    {"\\u0001", "\\u0001"},
+    {"\\u00e9", "\xc3\xa9"},
+    {"\x7f", "\x7f"},
+    {"\xc3\xa9", "\xc3\xa9"},
+    {"\xe2\x82\xac", "\xe2\x82\xac"},
+    {"\xf0\x9f\x98\x80", "\xf0\x9f\x98\x80"},
+    {"\"", ""},
+    {"\x01", ""},
+    {"\x1f", ""},
+    {"\xc3", ""},
+    {"\xff", ""}
+  };
+  std::string before;
+  std::string after;
+  std::string input;
+  std::string expected;
+  auto start(std::chrono::steady_clock::now());
+  for(size_t offset(0); offset < 64; ++offset) {
+    before.clear();
+    while(before.size() < offset) {
+      before += filler[before.size() % filler.size()];
+    }
+    for(size_t length(0); length <= 40; ++length) {
+      after.clear();
+      while(after.size() < length) {
+        after += filler[(offset + after.size()) % filler.size()];
+      }
+      for(const auto &special : specials) {
+        input = "\"" + before + special.first + after + "\"";
+        expected = special.second.empty() ? "" : ("\"" + before + special.second + after + "\"");
+        GlideJsonTest::checkScanned(input.data(), input.size(), expected);
+        input = "{" + input + ":" + input + "}";
+        expected = expected.empty() ? "" : ("{" + expected + ":" + expected + "}");
+        GlideJsonTest::checkScanned(input.data(), input.size(), expected);
+      }
+    }
+  }
+  std::cout << "JSON scan strings test: " << (std::chrono::steady_clock::now() - start).count() << "\n";
+}
+
+/*
+  Places every class of byte the encoder doesn't copy as is at every
+  offset below 64 of a string, followed by up to 40 plain bytes, and
+  checks every way of encoding it. Invalid UTF-8 is dropped, and the
+  bytes after "size" are never part of the string.
+*/
+void GlideJsonTest::testJsonEncodeRuns() {
+  const std::string filler("abcdefghijklmnopqrstuvwxyz0123456789 ,:[]{}/");
+  const std::string overrun("\"\\\x01\xc3");
+  // Each native sequence with its encoding, or nothing if it's dropped:
+  const std::pair<std::string, std::string> specials[] = {
+    {"\"", "\\\""},
+    {"\\", "\\\\"},
+    {"/", "/"},
+    {"\b", "\\b"},
+    {"\f", "\\f"},
+    {"\n", "\\n"},
+    {"\r", "\\r"},
+    {"\t", "\\t"},
+    {std::string(1, '\0'), "\\u0000"},
+    {"\x01", "\\u0001"},
+    {"\x1f", "\\u001f"},
+    {"\x7f", "\x7f"},
+    {"\xc3\xa9", "\xc3\xa9"},
+    {"\xe2\x82\xac", "\xe2\x82\xac"},
+    {"\xf0\x9f\x98\x80", "\xf0\x9f\x98\x80"},
+    {"\"\\\x01\xc3\xa9\n", "\\\"\\\\\\u0001\xc3\xa9\\n"},
+    {"\x80", ""},
+    {"\xc3", ""},
+    {"\xe2\x82", ""},
+    {"\xf0\x9f\x98", ""},
+    {"\xff", ""}
+  };
+  std::string before;
+  std::string after;
+  std::string input;
+  std::string expected;
+  std::string testEncoded;
+  GlideJson testJson;
+  char buffer[256];
+  size_t size;
+  auto start(std::chrono::steady_clock::now());
+  for(size_t offset(0); offset < 64; ++offset) {
+    before.clear();
+    while(before.size() < offset) {
+      before += filler[before.size() % filler.size()];
+    }
+    for(size_t length(0); length <= 40; ++length) {
+      after.clear();
+      while(after.size() < length) {
+        after += filler[(offset + after.size()) % filler.size()];
+      }
+      for(const auto &special : specials) {
+        input = before + special.first + after;
+        expected = "\"" + before + special.second + after + "\"";
+        testEncoded = GlideJson::encodeString(input);
+        if(testEncoded != expected) {
+          GlideJsonTest::errors.push_back("The string:\n\n" + input + "\n\n... was encoded as:\n\n" + testEncoded + "\n\n... instead of:\n\n" + expected + "\n");
+        }
+        testEncoded = GlideJson::encodeString((input + overrun).data(), input.size());
+        if(testEncoded != expected) {
+          GlideJsonTest::errors.push_back("The C string:\n\n" + input + "\n\n... was encoded as:\n\n" + testEncoded + "\n\n... instead of:\n\n" + expected + "\n");
+        }
+        testJson = GlideJson(GlideJson::Object);
+        testJson.object()[input] = GlideJson(input);
+        testEncoded = testJson.toJson();
+        if(testEncoded != "{" + expected + ":" + expected + "}") {
+          GlideJsonTest::errors.push_back("The object keyed by:\n\n" + input + "\n\n... was encoded as:\n\n" + testEncoded + "\n");
+        }
+        size = GlideJson(input).toJson(buffer, sizeof(buffer));
+        if(std::string(buffer, size) != expected) {
+          GlideJsonTest::errors.push_back("The string:\n\n" + input + "\n\n... was encoded into a buffer as:\n\n" + std::string(buffer, size) + "\n");
+        }
+        testJson = GlideJson::parse(expected);
+        if(testJson.isError() || (testJson.toJson() != expected)) {
+          GlideJsonTest::errors.push_back("The encoded string:\n\n" + expected + "\n\n... does not parse back to itself!");
+        }
+      }
+    }
+  }
+  std::cout << "JSON encode runs test: " << (std::chrono::steady_clock::now() - start).count() << "\n";
+}
+
+void GlideJsonTest::feedInChunks(const std::string &input, GlideJsonParser &parser) {
+  size_t offset(0);
+  size_t length;
+  size_t size(input.size());
+  while(offset < size) {
+    length = 1 + std::rand() % 16;
+    if(offset + length > size) {
+      length = size - offset;
+    }
+    parser.feed(input.data() + offset, length);
+    offset += length;
+  }
+}
+
+void GlideJsonTest::testJsonChunks() {
+  std::pair<std::string, std::string> generated;
+  std::string generatedBad;
+  GlideJsonParser parser;
+  GlideJson testJson;
+  std::string testEncoded;
+  unsigned int i;
+  auto start(std::chrono::steady_clock::now());
+  i = 5000;
+  do {
+    generated = GlideJsonTest::generateJsonWithWs();
+    GlideJsonTest::feedInChunks(generated.second, parser);
+    testJson = parser.finish();
+    testEncoded = testJson.toJson();
+    if(testEncoded != generated.first) {
+      GlideJsonTest::errors.push_back("The generated JSON fed in chunks:\n\n" + generated.second + "\n\n... does not match:\n\n" + testEncoded + "\n");
+    }
+  }
+  while(--i > 0);
+  i = 5000;
+  do {
+    generatedBad = (i & 1) ? GlideJsonTest::generateBadContainer() : GlideJsonTest::generateBadUtf8();
+    GlideJsonTest::feedInChunks(generatedBad, parser);
+    testJson = parser.finish();
+    if(testJson.getType() != GlideJson::Error) {
+      GlideJsonTest::errors.push_back("The generated JSON fed in chunks is somehow valid:\n\n" + generatedBad + "\n");
+    }
+    else if(testJson.error() != GlideJson::parse(generatedBad).error()) {
+      GlideJsonTest::errors.push_back("The generated JSON fed in chunks failed with:\n\n" + testJson.error() + "\n\n... instead of:\n\n" + GlideJson::parse(generatedBad).error() + "\n");
+    }
+  }
+  while(--i > 0);
+  // The same parser for whole documents, even after an unfinished one:
+  i = 5000;
+  do {
+    if(i & 1) {
+      parser.feed("[{\"unfinished\":\"");
+    }
+    generated = GlideJsonTest::generateJsonWithWs();
+    testEncoded = parser.parse(generated.second).toJson();
+    if(testEncoded != generated.first) {
+      GlideJsonTest::errors.push_back("The generated JSON parsed by a reused parser:\n\n" + generated.second + "\n\n... does not match:\n\n" + testEncoded + "\n");
+    }
+  }
+  while(--i > 0);
+  std::cout << "JSON chunks test: " << (std::chrono::steady_clock::now() - start).count() << "\n";
+}
+
+void GlideJsonTest::testJsonHandler() {
+  std::pair<std::string, std::string> generated;
+  std::string generatedBad;
+  GlideJsonTestHandler handler;
+  GlideJson testJson;
+  unsigned int i;
+  auto start(std::chrono::steady_clock::now());
+  i = 5000;
+  do {
+    generated = GlideJsonTest::generateJsonWithWs();
+    handler.output.clear();
+    testJson = GlideJson::parse(generated.second, handler);
+    if(testJson.getType() != GlideJson::Null) {
+      GlideJsonTest::errors.push_back("The generated JSON:\n\n" + generated.second + "\n\n... failed with a handler:\n\n" + testJson.error() + "\n");
+    }
+    else if(handler.output != generated.first) {
+      GlideJsonTest::errors.push_back("The generated JSON:\n\n" + generated.second + "\n\n... does not match the handler's events:\n\n" + handler.output + "\n");
+    }
+  }
+  while(--i > 0);
+  i = 5000;
+  do {
+    generatedBad = (i & 1) ? GlideJsonTest::generateBadContainer() : GlideJsonTest::generateBadUtf8();
+    testJson = GlideJson::parse(generatedBad.data(), generatedBad.size(), handler);
+    if(testJson.getType() != GlideJson::Error) {
+      GlideJsonTest::errors.push_back("The generated JSON is somehow valid with a handler:\n\n" + generatedBad + "\n");
+    }
+    else if(testJson.error() != GlideJson::parse(generatedBad).error()) {
+      GlideJsonTest::errors.push_back("The generated JSON failed with a handler with:\n\n" + testJson.error() + "\n\n... instead of:\n\n" + GlideJson::parse(generatedBad).error() + "\n");
+    }
+  }
+  while(--i > 0);
+  // Keys that are never given a value:
+  const char *keysWithoutValues[] = {"{\"a\"}", "[{\"a\"}]", "{\"a\":1,\"b\"}", "{\"a\":{\"b\"}}"};
+  i = 0;
+  do {
+    if(GlideJson::parse(keysWithoutValues[i]).getType() != GlideJson::Error) {
+      GlideJsonTest::errors.push_back(std::string("The JSON ") + keysWithoutValues[i] + " is somehow valid!\n");
+    }
+    if(GlideJson::parse(keysWithoutValues[i], handler).getType() != GlideJson::Error) {
+      GlideJsonTest::errors.push_back(std::string("The JSON ") + keysWithoutValues[i] + " is somehow valid with a handler!\n");
+    }
+  }
+  while(++i < 4);
+  std::cout << "JSON handler test: " << (std::chrono::steady_clock::now() - start).count() << "\n";
+}
+
+std::string GlideJsonTest::viewToJson(const GlideJsonView &input) {
+  std::string output;
+  GlideJsonViewIterator i;
+  switch(input.getType()) {
+    case GlideJson::Null:
+      return "null";
+    case GlideJson::Boolean:
+      return input.boolean() ? "true" : "false";
+    case GlideJson::Number:
+      return input.number();
+    case GlideJson::String:
+      return GlideJson::encodeString(input.string());
+    case GlideJson::Array:
+      output += '[';
+      for(i = input.begin(); i != input.end(); i.next()) {
+        if(output.size() > 1) {
+          output += ',';
+        }
+        output += GlideJsonTest::viewToJson(i.value());
+      }
+      return output + ']';
+    case GlideJson::Object:
+      output += '{';
+      for(i = input.begin(); i != input.end(); i.next()) {
+        if(output.size() > 1) {
+          output += ',';
+        }
+        output += GlideJson::encodeString(i.key()) + ':' + GlideJsonTest::viewToJson(i.value());
+      }
+      return output + '}';
+    default:
+      return "";
+  }
+}
+
+// Checks the random access of the view against the tree:
+void GlideJsonTest::compareView(const GlideJsonView &view, const GlideJson &input, const std::string &generated) {
+  size_t i;
+  size_t size;
+  switch(input.getType()) {
+    case GlideJson::Array:
+      size = input.array().size();
+      if(view.size() != size) {
+        GlideJsonTest::errors.push_back("The generated JSON:\n\n" + generated + "\n\n... has an array of the wrong size on the tape!\n");
+        return;
+      }
+      if(size) {
+        i = std::rand() % size;
+        if(GlideJsonTest::viewToJson(view[i]) != input.array()[i].toJson()) {
+          GlideJsonTest::errors.push_back("The generated JSON:\n\n" + generated + "\n\n... has the wrong element " + std::to_string(i) + " on the tape!\n");
+        }
+        GlideJsonTest::compareView(view[i], input.array()[i], generated);
+      }
+      break;
+    case GlideJson::Object:
+      if(view.size() != input.object().size()) {
+        GlideJsonTest::errors.push_back("The generated JSON:\n\n" + generated + "\n\n... has an object of the wrong size on the tape!\n");
+        return;
+      }
+      for(auto j(input.object().begin()); j != input.object().end(); j.next()) {
+        if(!view.count(j.key()) || (view.at(j.key()).toGlideJson().toJson() != j.value().toJson())) {
+          GlideJsonTest::errors.push_back("The generated JSON:\n\n" + generated + "\n\n... has the wrong value for the key " + GlideJson::encodeString(j.key()) + " on the tape!\n");
+        }
+        GlideJsonTest::compareView(view[j.key()], j.value(), generated);
+      }
+      if(view.count("\x01") && !input.object().count("\x01")) {
+        GlideJsonTest::errors.push_back("The generated JSON:\n\n" + generated + "\n\n... has a key that doesn't exist on the tape!\n");
+      }
+      break;
+    default:
+      break;
+  }
+}
+
+void GlideJsonTest::testJsonTape() {
+  std::pair<std::string, std::string> generated;
+  std::string generatedBad;
+  GlideJsonTape tape;
+  GlideJson testJson;
+  std::string testEncoded;
+  unsigned int i;
+  auto start(std::chrono::steady_clock::now());
+  i = 5000;
+  do {
+    generated = GlideJsonTest::generateJsonWithWs();
+    testJson = tape.parse(generated.second);
+    if(testJson.getType() != GlideJson::Null) {
+      GlideJsonTest::errors.push_back("The generated JSON:\n\n" + generated.second + "\n\n... failed on a tape:\n\n" + testJson.error() + "\n");
+      continue;
+    }
+    testEncoded = GlideJsonTest::viewToJson(tape.root());
+    if(testEncoded != generated.first) {
+      GlideJsonTest::errors.push_back("The generated JSON:\n\n" + generated.second + "\n\n... does not match its tape:\n\n" + testEncoded + "\n");
+    }
+    else if(tape.root().toGlideJson().toJson() != generated.first) {
+      GlideJsonTest::errors.push_back("The generated JSON:\n\n" + generated.second + "\n\n... is not restored from its tape!\n");
+    }
+    else {
+      GlideJsonTest::compareView(tape.root(), GlideJson::parse(generated.first), generated.second);
+    }
+  }
+  while(--i > 0);
+  i = 5000;
+  do {
+    generatedBad = (i & 1) ? GlideJsonTest::generateBadContainer() : GlideJsonTest::generateBadUtf8();
+    testJson = tape.parse(generatedBad.data(), generatedBad.size());
+    if(testJson.getType() != GlideJson::Error) {
+      GlideJsonTest::errors.push_back("The generated JSON is somehow valid on a tape:\n\n" + generatedBad + "\n");
+    }
+    else if(testJson.error() != GlideJson::parse(generatedBad).error()) {
+      GlideJsonTest::errors.push_back("The generated JSON failed on a tape with:\n\n" + testJson.error() + "\n\n... instead of:\n\n" + GlideJson::parse(generatedBad).error() + "\n");
+    }
+    else if(!tape.root().isError()) {
+      GlideJsonTest::errors.push_back("The generated JSON left a tape behind:\n\n" + generatedBad + "\n");
+    }
+  }
+  while(--i > 0);
+  std::cout << "JSON tape test: " << (std::chrono::steady_clock::now() - start).count() << "\n";
+}
+
+// Reads every string through "string()" so string views are materialized:
+std::string GlideJsonTest::stringsOf(const GlideJson &input) {
+  std::string output;
+  size_t i(0);
+  size_t size;
+  switch(input.getType()) {
+    case GlideJson::String:
+      return input.string() + '\n';
+    case GlideJson::Array:
+      size = input.array().size();
+      while(i < size) {
+        output += GlideJsonTest::stringsOf(input.array()[i]);
+        ++i;
+      }
+      return output;
+    case GlideJson::Object:
+      for(auto j(input.object().begin()); j != input.object().end(); j.next()) {
+        output += j.key() + '\n' + GlideJsonTest::stringsOf(j.value());
+      }
+      return output;
+    default:
+      return output;
+  }
+}
+
+void GlideJsonTest::testJsonShared() {
+  std::pair<std::string, std::string> generated;
+  std::string generatedBad;
+  GlideJson testJson;
+  GlideJson testCopy;
+  std::string testEncoded;
+  unsigned int i;
+  auto start(std::chrono::steady_clock::now());
+  i = 5000;
+  do {
+    generated = GlideJsonTest::generateJsonWithWs();
+    testJson = GlideJson::parseShared(std::string(generated.second));
+    testCopy = testJson;
+    testEncoded = testJson.toJson();
+    if(testEncoded != generated.first) {
+      GlideJsonTest::errors.push_back("The generated JSON parsed with views:\n\n" + generated.second + "\n\n... does not match:\n\n" + testEncoded + "\n");
+    }
+    else if(testCopy.toJson() != generated.first) {
+      GlideJsonTest::errors.push_back("The generated JSON parsed with views:\n\n" + generated.second + "\n\n... does not match its copy:\n\n" + testCopy.toJson() + "\n");
+    }
+    else if(GlideJsonTest::stringsOf(testJson) != GlideJsonTest::stringsOf(GlideJson::parse(generated.first))) {
+      GlideJsonTest::errors.push_back("The generated JSON parsed with views:\n\n" + generated.second + "\n\n... has the wrong strings!\n");
+    }
+    else if(testJson.toJson() != generated.first) {
+      GlideJsonTest::errors.push_back("The generated JSON parsed with views:\n\n" + generated.second + "\n\n... changed after reading its strings!\n");
+    }
+  }
+  while(--i > 0);
+  i = 5000;
+  do {
+    generatedBad = (i & 1) ? GlideJsonTest::generateBadContainer() : GlideJsonTest::generateBadUtf8();
+    testJson = GlideJson::parseShared(std::make_shared<const std::string>(generatedBad));
+    if(testJson.getType() != GlideJson::Error) {
+      GlideJsonTest::errors.push_back("The generated JSON is somehow valid with views:\n\n" + generatedBad + "\n");
+    }
+    else if(testJson.error() != GlideJson::parse(generatedBad).error()) {
+      GlideJsonTest::errors.push_back("The generated JSON failed with views with:\n\n" + testJson.error() + "\n\n... instead of:\n\n" + GlideJson::parse(generatedBad).error() + "\n");
+    }
+  }
+  while(--i > 0);
+  // Modifying a view, then dropping the input:
+  std::shared_ptr<const std::string> input(std::make_shared<const std::string>("[\"abc\",\"d\\ne\",{\"f\":\"g\"}]"));
+  testJson = GlideJson::parseShared(input);
+  input.reset();
+  testJson.array()[0].string() += '!';
+  testJson.array()[2].object()["f"].string() += '?';
+  testEncoded = testJson.toJson();
+  if(testEncoded != "[\"abc!\",\"d\\ne\",{\"f\":\"g?\"}]") {
+    GlideJsonTest::errors.push_back("Modifying JSON parsed with views results in:\n\n" + testEncoded + "\n");
+  }
+  std::cout << "JSON shared test: " << (std::chrono::steady_clock::now() - start).count() << "\n";
+}
+
+// Picks a random path down the JSON, using a wildcard for some array positions:
+std::string GlideJsonTest::randomPath(const GlideJson &input, std::vector<std::string> &tokens) {
+  std::string output;
+  std::string token;
+  const GlideJson *current(&input);
+  size_t i;
+  size_t position;
+  while(std::rand() % 4) {
+    if(current->isArray() && current->array().size()) {
+      position = std::rand() % current->array().size();
+      tokens.push_back(std::to_string(position));
+      output += (std::rand() & 1) ? "/*" : ("/" + tokens.back());
+      current = &(current->array()[position]);
+    }
+    else if(current->isObject() && current->object().size()) {
+      position = std::rand() % current->object().size();
+      auto j(current->object().begin());
+      while(position--) {
+        j.next();
+      }
+      tokens.push_back(j.key());
+      token.clear();
+      i = 0;
+      while(i < j.key().size()) {
+        if(j.key()[i] == '~') {
+          token += "~0";
+        }
+        else if(j.key()[i] == '/') {
+          token += "~1";
+        }
+        else {
+          token += j.key()[i];
+        }
+        ++i;
+      }
+      output += "/" + token;
+      current = &(j.value());
+    }
+    else {
+      break;
+    }
+  }
+  return output;
+}
+
+void GlideJsonTest::testJsonSelector() {
+  std::pair<std::string, std::string> generated;
+  GlideJson testJson;
+  GlideJson checkJson;
+  std::vector<std::string> tokens;
+  std::string path;
+  const GlideJson *selected;
+  const GlideJson *expected;
+  size_t i;
+  unsigned int j;
+  auto start(std::chrono::steady_clock::now());
+  j = 5000;
+  do {
+    generated = GlideJsonTest::generateJsonWithWs();
+    checkJson = GlideJson::parse(generated.first);
+    tokens.clear();
+    path = GlideJsonTest::randomPath(checkJson, tokens);
+    testJson = GlideJson::parse(generated.second, GlideJsonSelector(std::vector<std::string>(1, path)));
+    selected = &testJson;
+    expected = &checkJson;
+    i = 0;
+    while((i < tokens.size()) && selected->getType() == expected->getType()) {
+      if(expected->isArray()) {
+        if(selected->array().size() != expected->array().size()) {
+          break;
+        }
+        selected = &(selected->array()[std::stoul(tokens[i])]);
+        expected = &(expected->array()[std::stoul(tokens[i])]);
+      }
+      else if(selected->object().count(tokens[i]) && (selected->object().size() == 1)) {
+        selected = &(selected->object().at(tokens[i]));
+        expected = &(expected->object().at(tokens[i]));
+      }
+      else {
+        break;
+      }
+      ++i;
+    }
+    if((i != tokens.size()) || (selected->toJson() != expected->toJson())) {
+      GlideJsonTest::errors.push_back("The generated JSON:\n\n" + generated.second + "\n\n... does not select \"" + path + "\" properly:\n\n" + testJson.toJson() + "\n");
+    }
+  }
+  while(--j > 0);
+  // Overlapping paths, missing paths, and paths that end early:
+  std::string input("{\"user\":{\"id\":7,\"name\":\"x\"},\"items\":[{\"price\":1,\"q\":2},{\"q\":3},5,{\"price\":\"a\\nb\"}],\"a/b\":1}");
+  std::vector<std::pair<std::vector<std::string>, std::string> > cases = {
+    {{"/user/id", "/items/*/price"}, "{\"user\":{\"id\":7},\"items\":[{\"price\":1},{},null,{\"price\":\"a\\nb\"}]}"},
+    {{"/items/0/q", "/items/*/price"}, "{\"items\":[{\"price\":1,\"q\":2},{},null,{\"price\":\"a\\nb\"}]}"},
+    {{"/a~1b", "/user/id/deeper", "/missing"}, "{\"user\":{},\"a/b\":1}"}
+  };
+  i = 0;
+  while(i < cases.size()) {
+    path = GlideJson::parse(input, GlideJsonSelector(cases[i].first)).toJson();
+    if(path != cases[i].second) {
+      GlideJsonTest::errors.push_back("The selector " + std::to_string(i) + " results in:\n\n" + path + "\n\n... instead of:\n\n" + cases[i].second + "\n");
+    }
+    ++i;
+  }
+  // Selected numbers carry their binary value like parsed ones:
+  GlideJson numbers(GlideJson::parse("{\"a\":-12,\"b\":[2.5e-1,1e400]}", GlideJsonSelector({"/a", "/b/*"})));
+  long int selectedLong(0);
+  if(!numbers.object()["a"].toLong(selectedLong) || (selectedLong != -12) || (numbers.object()["b"].array()[0].toDouble() != 0.25) || (numbers.object()["b"].array()[1].toJson() != "1e400")) {
+    GlideJsonTest::errors.push_back("Selected numbers do not keep their values:\n\n" + numbers.toJson() + "\n");
+  }
+  std::cout << "JSON selector test: " << (std::chrono::steady_clock::now() - start).count() << "\n";
+}
+
+void GlideJsonTest::testJsonValidate() {
+  std::pair<std::string, std::string> generated;
+  std::string generatedBad;
+  size_t index;
+  unsigned int i;
+  auto start(std::chrono::steady_clock::now());
+  i = 5000;
+  do {
+    generated = GlideJsonTest::generateJsonWithWs();
+    if(!GlideJson::validate(generated.first) || !GlideJson::validate(generated.second.data(), generated.second.size())) {
+      GlideJsonTest::errors.push_back("The generated JSON is somehow invalid:\n\n" + generated.second + "\n");
+    }
+  }
+  while(--i > 0);
+  i = 5000;
+  do {
+    generatedBad = (i & 1) ? GlideJsonTest::generateBadContainer() : GlideJsonTest::generateBadUtf8();
+    if(GlideJson::validate(generatedBad, index)) {
+      GlideJsonTest::errors.push_back("The generated JSON is somehow valid:\n\n" + generatedBad + "\n");
+    }
+    else if(("Parsing failed at index " + std::to_string(index) + "!") != GlideJson::parse(generatedBad).error()) {
+      GlideJsonTest::errors.push_back("The generated JSON failed validation at index " + std::to_string(index) + " instead of:\n\n" + GlideJson::parse(generatedBad).error() + "\n");
+    }
+  }
+  while(--i > 0);
+  if(GlideJson::validate("") || GlideJson::validate("{\"a\"}") || !GlideJson::validate(" [] ")) {
+    GlideJsonTest::errors.push_back("Validation of the basic cases failed!\n");
+  }
+  std::cout << "JSON validation test: " << (std::chrono::steady_clock::now() - start).count() << "\n";
+}
+
+void GlideJsonTest::testJsonLines() {
+  std::vector<std::string> records;
+  std::string input;
+  std::string record;
+  std::vector<GlideJson> testJsons;
+  size_t expected(0);
+  size_t i;
+  auto start(std::chrono::steady_clock::now());
+  i = 3000;
+  do {
+    switch(std::rand() % 4) {
+      case 0:
+        record = GlideJsonTest::generateBadContainer();
+        if(record.find('\n') != std::string::npos) {
+          record = "[1,]";
+        }
+        break;
+      case 1:
+        record = "";
+        break;
+      default:
+        record = GlideJsonTest::generateJsonWithWs().first;
+    }
+    records.push_back(record);
+    input += record + ((std::rand() & 1) ? "\n" : "\r\n");
+  }
+  while(--i > 0);
+  // The last record without a newline:
+  records.push_back("{\"last\":true}");
+  input += records.back();
+  auto check([&](size_t line, GlideJson &testJson) {
+    GlideJson checkJson(GlideJson::parse(records[line]));
+    if(line != expected) {
+      GlideJsonTest::errors.push_back("The JSON line " + std::to_string(line) + " came out of order!\n");
+    }
+    else if(checkJson.isError() ? (testJson.error() != checkJson.error()) : (testJson.toJson() != checkJson.toJson())) {
+      GlideJsonTest::errors.push_back("The JSON line:\n\n" + records[line] + "\n\n... does not match:\n\n" + (testJson.isError() ? testJson.error() : testJson.toJson()) + "\n");
+    }
+    ++expected;
+  });
+  testJsons = GlideJsonLines(4).parse(input);
+  i = 0;
+  while(i < testJsons.size()) {
+    check(i, testJsons[i]);
+    ++i;
+  }
+  expected = 0;
+  GlideJsonLines(3).parse(input.data(), input.size(), check);
+  if(expected != records.size()) {
+    GlideJsonTest::errors.push_back("The JSON lines passed to a callback are incomplete!\n");
+  }
+  expected = 0;
+  const char *path("GlideJsonTest.ndjson");
+  std::ofstream file(path, std::ios::binary);
+  file << input;
+  file.close();
+  if(!GlideJsonLines().parseFile(path, check) || (expected != records.size())) {
+    GlideJsonTest::errors.push_back("The JSON lines file was not parsed properly!\n");
+  }
+  std::remove(path);
+  std::cout << "JSON lines test: " << (std::chrono::steady_clock::now() - start).count() << "\n";
+}
+
+void GlideJsonTest::testJsonParseInto() {
+  std::string generated;
+  GlideJson testJson;
+  GlideJson checkJson;
+  bool parsed;
+  unsigned int i;
+  auto start(std::chrono::steady_clock::now());
+  // Whatever the previous document was, the result is the same as "parse":
+  i = 5000;
+  do {
+    switch(std::rand() % 4) {
+      case 0:
+        generated = GlideJsonTest::generateBadContainer();
+        break;
+      case 1:
+        // Strings that refer to the input have to be replaced:
+        testJson = GlideJson::parseShared(GlideJsonTest::generateJson(5 + (std::rand() % 2)));
+        generated = GlideJsonTest::generateJsonWithWs().second;
+        break;
+      default:
+        generated = GlideJsonTest::generateJsonWithWs().second;
+    }
+    parsed = GlideJson::parseInto(testJson, generated);
+    checkJson = GlideJson::parse(generated);
+    if(parsed != checkJson.notError()) {
+      GlideJsonTest::errors.push_back("Parsing into an existing GlideJson returned the wrong status for:\n\n" + generated + "\n");
+    }
+    else if(checkJson.isError() ? (testJson.error() != checkJson.error()) : (testJson.toJson() != checkJson.toJson())) {
+      GlideJsonTest::errors.push_back("The JSON parsed into an existing GlideJson:\n\n" + generated + "\n\n... does not match:\n\n" + (testJson.isError() ? testJson.error() : testJson.toJson()) + "\n");
+    }
+  }
+  while(--i > 0);
+  // The same shape keeps the same containers and buffers:
+  GlideJson::parseInto(testJson, "{\"a\":[1,2,3],\"s\":\"hello there\",\"o\":{\"x\":true}}");
+  const std::vector<GlideJson> *array(&(testJson.object().at("a").array()));
+  const char *string(testJson.object().at("s").string().data());
+  const GlideHashMap<GlideJson> *object(&(testJson.object().at("o").object()));
+  GlideJson::parseInto(testJson, "{\"a\":[4,5,6],\"s\":\"hi\\u0020there\",\"o\":{\"x\":false}}");
+  if(
+    (array != &(testJson.object().at("a").array()))
+    || (string != testJson.object().at("s").string().data())
+    || (object != &(testJson.object().at("o").object()))
+    || (testJson.toJson() != "{\"a\":[4,5,6],\"s\":\"hi there\",\"o\":{\"x\":false}}")
+  ) {
+    GlideJsonTest::errors.push_back("Parsing into a GlideJson of the same shape did not reuse it!\n");
+  }
+  // Reordered, missing, and duplicate keys:
+  generated = "{\"o\":{},\"a\":[7],\"a\":[],\"t\":null}";
+  GlideJson::parseInto(testJson, generated);
+  if(testJson.toJson() != GlideJson::parse(generated).toJson()) {
+    GlideJsonTest::errors.push_back("Parsing into a GlideJson with different keys results in:\n\n" + testJson.toJson() + "\n");
+  }
+  std::cout << "JSON parse into test: " << (std::chrono::steady_clock::now() - start).count() << "\n";
+}
+
+void GlideJsonTest::testJsonIntegers() {
+  std::mt19937_64 generator(std::rand());
+  GlideJsonParser parser;
+  GlideJsonTape tape;
+  GlideJson testJson;
+  GlideJson reusedJson;
+  std::string generated;
+  std::string digits;
+  long int expected;
+  long int testLong;
+  unsigned long int testULong;
+  size_t zeros;
+  unsigned int i;
+  auto start(std::chrono::steady_clock::now());
+  // The same integer written in every way JSON allows, through every way of parsing it:
+  i = 20000;
+  do {
+    expected = (long int)(generator() >> (std::rand() % 64));
+    if(std::rand() & 1) {
+      expected = -expected;
+    }
+    digits = std::to_string(expected);
+    // Zero can't have leading zeros:
+    zeros = expected ? (std::rand() % 4) : 0;
+    switch(std::rand() % 5) {
+      case 0:
+        generated = digits;
+        break;
+      case 1:
+        generated = digits + "." + std::string(zeros + 1, '0');
+        break;
+      case 2:
+        generated = digits + std::string(zeros, '0') + ((std::rand() & 1) ? "e-" : "E-") + std::to_string(zeros);
+        break;
+      case 3:
+        generated = digits + ((std::rand() & 1) ? "e+0" : "E0");
+        break;
+      default:
+        // Moves the decimal point to the left and the exponent back to the right:
+        zeros = std::min(zeros, digits.size() - 1 - (expected < 0));
+        generated = digits.substr(0, digits.size() - zeros) + (zeros ? "." : "") + digits.substr(digits.size() - zeros) + "e" + std::to_string(zeros);
+    }
+    switch(i % 4) {
+      case 0:
+        testJson = GlideJson::parse(generated);
+        break;
+      case 1:
+        GlideJsonTest::feedInChunks(generated, parser);
+        testJson = parser.finish();
+        break;
+      case 2:
+        GlideJson::parseInto(reusedJson, "[" + generated + "]");
+        testJson = reusedJson.array()[0];
+        break;
+      default:
+        tape.parse(generated);
+        tape.root().toLong(testLong);
+        testJson = GlideJson(testLong);
+    }
+    if(!testJson.toLong(testLong) || (testLong != expected) || ((generated == digits) && (testJson.toLong() != expected))) {
+      GlideJsonTest::errors.push_back("The number:\n\n" + generated + "\n\n... is not the integer:\n\n" + std::to_string(expected) + "\n");
+    }
+    else if((expected >= 0) != testJson.toULong(testULong)) {
+      GlideJsonTest::errors.push_back("The number:\n\n" + generated + "\n\n... has the wrong sign!\n");
+    }
+  }
+  while(--i > 0);
+  // The limits of each type, fractions, and digits past what 64 bits can hold:
+  struct {
+    const char *input;
+    bool exact;
+    int expectedInt;
+    bool exactUInt;
+    unsigned int expectedUInt;
+    bool exactULong;
+    unsigned long int expectedULong;
+  } cases[] = {
+    {"2147483647", true, 2147483647, true, 2147483647U, true, 2147483647UL},
+    {"2147483648", false, 2147483647, true, 2147483648U, true, 2147483648UL},
+    {"-2147483648", true, -2147483647 - 1, false, 0, false, 0},
+    {"-2147483649", false, -2147483647 - 1, false, 0, false, 0},
+    {"4294967296", false, 2147483647, false, 4294967295U, true, 4294967296UL},
+    {"18446744073709551615", false, 2147483647, false, 4294967295U, true, 18446744073709551615UL},
+    {"18446744073709551616", false, 2147483647, false, 4294967295U, false, 18446744073709551615UL},
+    {"184467440737095516150e-1", false, 2147483647, false, 4294967295U, true, 18446744073709551615UL},
+    {"184467440737095516160e-1", false, 2147483647, false, 4294967295U, false, 18446744073709551615UL},
+    {"123456789012345678901234567890e-10", false, 2147483647, false, 4294967295U, false, 12345678901234567890UL},
+    {"1.5", false, 1, false, 1, false, 1},
+    {"-1.5", false, -1, false, 0, false, 0},
+    {"-0.5", false, 0, false, 0, false, 0},
+    {"-0", true, 0, true, 0, true, 0},
+    {"0.000e99999999999", true, 0, true, 0, true, 0},
+    {"125e-2", false, 1, false, 1, false, 1},
+    {"1.25e2", true, 125, true, 125, true, 125},
+    {"1e400", false, 2147483647, false, 4294967295U, false, 18446744073709551615UL},
+    {"1e-400", false, 0, false, 0, false, 0}
+  };
+  int testInt;
+  unsigned int testUInt;
+  i = 0;
+  while(i < sizeof(cases) / sizeof(cases[0])) {
+    testJson = GlideJson::parse(cases[i].input);
+    tape.parse(cases[i].input, std::strlen(cases[i].input));
+    if(
+      (testJson.toInt(testInt) != cases[i].exact) || (testInt != cases[i].expectedInt)
+      || (testJson.toUInt(testUInt) != cases[i].exactUInt) || (testUInt != cases[i].expectedUInt)
+      || (testJson.toULong(testULong) != cases[i].exactULong) || (testULong != cases[i].expectedULong)
+      || (tape.root().toInt(testInt) != cases[i].exact) || (testInt != cases[i].expectedInt)
+      || (tape.root().toULong(testULong) != cases[i].exactULong) || (testULong != cases[i].expectedULong)
+    ) {
+      GlideJsonTest::errors.push_back("The number " + std::string(cases[i].input) + " was not converted properly!\n");
+    }
+    ++i;
+  }
+  // Everything else about a number is kept along with its value:
+  testJson = GlideJson(-5);
+  GlideJson copiedJson(testJson);
+  testInt = 0;
+  if(!copiedJson.toInt(testInt) || (testInt != -5) || GlideJson("5").toInt(testInt) || (testInt != 0)) {
+    GlideJsonTest::errors.push_back("The number -5 did not survive a copy!\n");
+  }
+  // The overloads without an output still read the text like std::stoul and friends:
+  generated = "[-1,1e2,1.9]";
+  tape.parse(generated);
+  testJson = GlideJson::parse(generated);
+  if(
+    (testJson.array()[0].toUInt() != (unsigned int)std::stoul("-1")) || (testJson.array()[0].toULong() != std::stoul("-1"))
+    || (testJson.array()[1].toInt() != 1) || (testJson.array()[2].toLong() != 1)
+    || (tape.root().at(0).toUInt() != (unsigned int)std::stoul("-1")) || (tape.root().at(1).toInt() != 1)
+  ) {
+    GlideJsonTest::errors.push_back("The integer accessors without an output changed how they read numbers!\n");
+  }
+  try {
+    GlideJson::parse("99999999999").toInt();
+    GlideJsonTest::errors.push_back("The number 99999999999 was converted to an int!\n");
+  }
+  catch(const std::out_of_range &) {
+  }
+  std::cout << "JSON integers test: " << (std::chrono::steady_clock::now() - start).count() << "\n";
+}
+
+void GlideJsonTest::testJsonDoubles() {
+  std::mt19937_64 generator(std::rand());
+  GlideJsonTape tape;
+  GlideJson testJson;
+  std::string generated;
+  char formatted[64];
+  uint64_t bits;
+  double value;
+  double expected;
+  double testDouble;
+  float expectedFloat;
+  float testFloat;
+  size_t j;
+  unsigned int i;
+  auto start(std::chrono::steady_clock::now());
+  // Any finite double, printed to any precision, must come back exactly like strtod would have it:
+  i = 50000;
+  do {
+    bits = generator();
+    std::memcpy(&value, &bits, sizeof(value));
+    if(!(std::fabs(value) <= std::numeric_limits<double>::max())) {
+      continue;
+    }
+    std::snprintf(formatted, sizeof(formatted), "%.*g", (int)(std::rand() % 17) + 1, value);
+    generated.clear();
+    j = 0;
+    // JSON has no '+' in exponents:
+    while(formatted[j]) {
+      if(formatted[j] != '+') {
+        generated += formatted[j];
+      }
+      ++j;
+    }
+    // Digits past what 64 bits can hold force the slow path every so often:
+    if(!(i % 8) && (generated.find('.') != std::string::npos) && (generated.find('e') == std::string::npos)) {
+      generated += std::string(std::rand() % 24, '0') + (char)('0' + std::rand() % 10);
+    }
+    expected = std::strtod(generated.c_str(), NULL);
+    expectedFloat = std::strtof(generated.c_str(), NULL);
+    // Fewer digits can round past the largest double, which the cases below cover:
+    if(!(std::fabs(expected) <= std::numeric_limits<double>::max())) {
+      continue;
+    }
+    if(i & 1) {
+      testJson = GlideJson::parse(generated);
+      testDouble = testJson.toDouble();
+      testJson.toFloat(testFloat);
+    }
+    else {
+      tape.parse(generated);
+      testDouble = tape.root().toDouble();
+      tape.root().toFloat(testFloat);
+    }
+    if(std::memcmp(&testDouble, &expected, sizeof(expected))) {
+      GlideJsonTest::errors.push_back("The number:\n\n" + generated + "\n\n... is not the double it should be!\n");
+    }
+    else if((std::fabs(expectedFloat) <= std::numeric_limits<float>::max()) && std::memcmp(&testFloat, &expectedFloat, sizeof(expectedFloat))) {
+      GlideJsonTest::errors.push_back("The number:\n\n" + generated + "\n\n... is not the float it should be!\n");
+    }
+  }
+  while(--i > 0);
+  // Rounding at the edges of each type, and values out of range:
+  struct {
+    const char *input;
+    bool exact;
+    double expected;
+    bool exactFloat;
+    float expectedFloat;
+  } cases[] = {
+    {"-0", true, -0.0, true, -0.0f},
+    {"0.1", true, 0.1, true, 0.1f},
+    {"1e23", true, 1e23, true, 1e23f},
+    {"9007199254740993", true, 9007199254740992.0, true, 9007199254740992.0f},
+    {"9007199254740993.000000000000000000001", true, 9007199254740994.0, true, 9007199254740992.0f},
+    {"2.4703282292062327e-324", true, 0.0, true, 0.0f},
+    {"2.4703282292062328e-324", true, 4.9406564584124654e-324, true, 0.0f},
+    {"1e-400", true, 0.0, true, 0.0f},
+    {"1.4e-45", true, 1.4e-45, true, 1.4e-45f},
+    {"3.4028235e38", true, 3.4028235e38, true, 3.4028235e38f},
+    {"3.4028236e38", true, 3.4028236e38, false, std::numeric_limits<float>::max()},
+    {"1.7976931348623158e308", true, std::numeric_limits<double>::max(), false, std::numeric_limits<float>::max()},
+    {"1.7976931348623159e308", false, std::numeric_limits<double>::max(), false, std::numeric_limits<float>::max()},
+    {"-1e400", false, -std::numeric_limits<double>::max(), false, -std::numeric_limits<float>::max()}
+  };
+  i = 0;
+  while(i < sizeof(cases) / sizeof(cases[0])) {
+    testJson = GlideJson::parse(cases[i].input);
+    tape.parse(cases[i].input, std::strlen(cases[i].input));
+    if(
+      (testJson.toDouble(testDouble) != cases[i].exact) || std::memcmp(&testDouble, &cases[i].expected, sizeof(double))
+      || (testJson.toFloat(testFloat) != cases[i].exactFloat) || std::memcmp(&testFloat, &cases[i].expectedFloat, sizeof(float))
+      || (tape.root().toDouble(testDouble) != cases[i].exact) || std::memcmp(&testDouble, &cases[i].expected, sizeof(double))
+    ) {
+      GlideJsonTest::errors.push_back("The number " + std::string(cases[i].input) + " was not converted properly!\n");
+    }
+    ++i;
+  }
+  try {
+    GlideJson::parse("1e400").toDouble();
+    GlideJsonTest::errors.push_back("The number 1e400 was converted to a double!\n");
+  }
+  catch(const GlideError &) {
+  }
+  std::cout << "JSON doubles test: " << (std::chrono::steady_clock::now() - start).count() << "\n";
+}
+
+void GlideJsonTest::testJsonShortestDoubles() {
+  std::mt19937_64 generator(std::rand());
+  GlideJson testJson;
+  std::string testEncoded;
+  std::string significand;
+  char formatted[64];
+  uint64_t bits;
+  double value;
+  double testDouble;
+  size_t fewest;
+  size_t j;
+  unsigned int i;
+  auto start(std::chrono::steady_clock::now());
+  // Any finite double must read back exactly, with no more digits than the shortest printf finds:
+  i = 20000;
+  do {
+    bits = generator() >> ((i & 1) ? 0 : (std::rand() % 64));
+    std::memcpy(&value, &bits, sizeof(value));
+    if(!(std::fabs(value) <= std::numeric_limits<double>::max())) {
+      continue;
+    }
+    if(i & 2) {
+      testJson = GlideJson(value);
+    }
+    else {
+      testJson = value;
+    }
+    testEncoded = testJson.toJson();
+    testDouble = std::strtod(testEncoded.c_str(), NULL);
+    if(std::memcmp(&testDouble, &value, sizeof(value)) || !GlideJson::parse(testEncoded).toDouble(testDouble) || std::memcmp(&testDouble, &value, sizeof(value))) {
+      GlideJsonTest::errors.push_back("The double " + testEncoded + " does not read back as itself!\n");
+      continue;
+    }
+    fewest = 1;
+    while(fewest < 17) {
+      std::snprintf(formatted, sizeof(formatted), "%.*e", (int)fewest - 1, value);
+      if(std::strtod(formatted, NULL) == value) {
+        break;
+      }
+      ++fewest;
+    }
+    // The significant digits, without the sign, the point, or leading and trailing zeros:
+    significand.clear();
+    j = 0;
+    while((j < testEncoded.size()) && (testEncoded[j] != 'e')) {
+      if((testEncoded[j] >= '0') && (testEncoded[j] <= '9') && (!significand.empty() || (testEncoded[j] != '0'))) {
+        significand += testEncoded[j];
+      }
+      ++j;
+    }
+    if((significand.find_last_not_of('0') + 1) > fewest) {
+      GlideJsonTest::errors.push_back("The double " + testEncoded + " is not the shortest it can be!\n");
+    }
+  }
+  while(--i > 0);
+  struct {
+    double input;
+    const char *expected;
+  } cases[] = {
+    {0.0, "0"},
+    {-0.0, "-0"},
+    {-1.5, "-1.5"},
+    {100.0, "100"},
+    {0.1, "0.1"},
+    {2.0 / 3.0, "0.6666666666666666"},
+    {1e20, "100000000000000000000"},
+    {1e21, "1e21"},
+    {0.000001, "0.000001"},
+    {1.5e-7, "1.5e-7"},
+    {5e-324, "5e-324"},
+    {std::numeric_limits<double>::max(), "1.7976931348623157e308"},
+    {std::numeric_limits<double>::quiet_NaN(), "null"},
+    {-std::numeric_limits<double>::infinity(), "null"}
+  };
+  i = 0;
+  while(i < sizeof(cases) / sizeof(cases[0])) {
+    testEncoded = GlideJson(cases[i].input).toJson();
+    if(testEncoded != cases[i].expected) {
+      GlideJsonTest::errors.push_back("The double " + std::string(cases[i].expected) + " was written as " + testEncoded + "!\n");
+    }
+    ++i;
+  }
+  std::cout << "JSON shortest doubles test: " << (std::chrono::steady_clock::now() - start).count() << "\n";
+}
+
+void GlideJsonTest::testJsonParseInParallel() {
+  const char corruptions[] = {'}', ']', ',', ':', '"', '\x0C', '\x02', 'x'};
+  std::string input;
+  std::string corrupted;
+  GlideJson testJson;
+  GlideJson checkJson;
+  size_t elements;
+  unsigned int i(8);
+  auto start(std::chrono::steady_clock::now());
+  do {
+    // Big enough to be split, with the keys of objects repeating now and then:
+    input = (i & 1) ? "[" : " \n{";
+    elements = 0;
+    while(input.size() < ((size_t)5 << 18)) {
+      if(elements) {
+        input += (std::rand() & 1) ? "," : " ,\n";
+      }
+      if(!(i & 1)) {
+        input += "\"" + std::to_string(std::rand() % 4000) + "\":";
+      }
+      input += GlideJsonTest::generateJsonWithWs().second;
+      ++elements;
+    }
+    input += (i & 1) ? "]" : "}\t";
+    testJson = GlideJson::parseInParallel(input, i);
+    checkJson = GlideJson::parse(input);
+    if(testJson.toJson() != checkJson.toJson()) {
+      GlideJsonTest::errors.push_back("A document of " + std::to_string(elements) + " elements was not parsed in parallel properly!\n");
+    }
+    // A single bad byte anywhere must be reported exactly like a sequential parse would:
+    corrupted = input;
+    corrupted[std::rand() % corrupted.size()] = corruptions[std::rand() % sizeof(corruptions)];
+    testJson = GlideJson::parseInParallel(corrupted, 4);
+    checkJson = GlideJson::parse(corrupted);
+    if(checkJson.isError() ? (!testJson.isError() || (testJson.error() != checkJson.error())) : (testJson.toJson() != checkJson.toJson())) {
+      GlideJsonTest::errors.push_back("A corrupted document was not parsed in parallel like it is sequentially:\n\n" + (testJson.isError() ? testJson.error() : std::string("No error")) + "\n");
+    }
+  }
+  while(--i > 0);
+  // Small documents and scalars are simply parsed sequentially:
+  if((GlideJson::parseInParallel("[1,2]", 4).toJson() != "[1,2]") || (GlideJson::parseInParallel(" 3 ", 0).toJson() != "3")) {
+    GlideJsonTest::errors.push_back("A small document was not parsed in parallel properly!\n");
+  }
+  std::cout << "JSON parse in parallel test: " << (std::chrono::steady_clock::now() - start).count() << "\n";
+}
+
+void GlideJsonTest::testJsonParseFile() {
+  const char *path("GlideJsonTest.json");
+  std::pair<std::string, std::string> generated;
+  std::ofstream file;
+  GlideJson testJson;
+  unsigned int i;
+  auto start(std::chrono::steady_clock::now());
+  i = 200;
+  do {
+    generated = GlideJsonTest::generateJsonWithWs();
+    file.open(path, std::ios::binary | std::ios::trunc);
+    file << generated.second;
+    file.close();
+    testJson = (i & 1) ? GlideJson::parseFile(path) : GlideJson::parseFileShared(path);
+    if(testJson.toJson() != generated.first) {
+      GlideJsonTest::errors.push_back("The generated JSON file:\n\n" + generated.second + "\n\n... does not match:\n\n" + testJson.toJson() + "\n");
+    }
+  }
+  while(--i > 0);
+  // Strings still referring to the file once it's gone:
+  file.open(path, std::ios::binary | std::ios::trunc);
+  file << "[\"abc\",{\"d\":\"e\\tf\",\"g\":\"h\"}]";
+  file.close();
+  testJson = GlideJson::parseFileShared(path);
+  std::remove(path);
+  if((testJson.array()[0].string() != "abc") || (testJson.toJson() != "[\"abc\",{\"d\":\"e\\tf\",\"g\":\"h\"}]")) {
+    GlideJsonTest::errors.push_back("A JSON file parsed with views does not survive its removal:\n\n" + testJson.toJson() + "\n");
+  }
+  // An empty file is invalid JSON, and a missing one can't be read:
+  file.open(path, std::ios::binary | std::ios::trunc);
+  file.close();
+  testJson = GlideJson::parseFile(path);
+  if(!testJson.isError() || (testJson.error() != GlideJson::parse("").error())) {
+    GlideJsonTest::errors.push_back("An empty JSON file was not rejected properly!\n");
+  }
+  std::remove(path);
+  testJson = GlideJson::parseFileShared(path);
+  if(!testJson.isError() || (testJson.error() != "Reading GlideJsonTest.json failed!")) {
+    GlideJsonTest::errors.push_back("A missing JSON file was not reported properly!\n");
+  }
+  // Neither is a directory, and it must not take the process down:
+  testJson = GlideJson::parseFile(".");
+  if(!testJson.isError() || (testJson.error() != "Reading . failed!")) {
+    GlideJsonTest::errors.push_back("A directory was not reported properly by parseFile!\n");
+  }
+  testJson = GlideJson::parseFileShared(".");
+  if(!testJson.isError() || (testJson.error() != "Reading . failed!")) {
+    GlideJsonTest::errors.push_back("A directory was not reported properly by parseFileShared!\n");
+  }
+  std::cout << "JSON parse file test: " << (std::chrono::steady_clock::now() - start).count() << "\n";
+}
+
+void GlideJsonTest::testJsonArrayReader() {
+  const char corruptions[] = {'}', ']', ',', ':', '"', '\\', '\x0C', '\x02', 'x'};
+  std::vector<std::string> elements;
+  std::string input;
+  std::string corrupted;
+  std::istringstream stream;
+  GlideJson testJson;
+  GlideJson checkJson;
+  size_t count;
+  unsigned int i(100);
+  auto start(std::chrono::steady_clock::now());
+  do {
+    elements.clear();
+    input = " [";
+    count = std::rand() % 20;
+    while(elements.size() < count) {
+      if(!elements.empty()) {
+        input += (std::rand() & 1) ? "," : " ,\n";
+      }
+      std::pair<std::string, std::string> generated(GlideJsonTest::generateJsonWithWs());
+      elements.push_back(generated.first);
+      input += generated.second;
+    }
+    input += "]\n";
+    // Tiny buffers cut through strings, escapes and brackets:
+    stream.clear();
+    stream.str(input);
+    GlideJsonArrayReader reader(stream, 1 + std::rand() % 16);
+    count = 0;
+    while(reader.next(testJson)) {
+      if((count >= elements.size()) || (testJson.toJson() != elements[count])) {
+        GlideJsonTest::errors.push_back("The streamed JSON array:\n\n" + input + "\n\n... does not match at element " + std::to_string(count) + ":\n\n" + (testJson.isError() ? testJson.error() : testJson.toJson()) + "\n");
+        break;
+      }
+      ++count;
+    }
+    if(count != elements.size()) {
+      GlideJsonTest::errors.push_back("The streamed JSON array:\n\n" + input + "\n\n... ended after " + std::to_string(count) + " elements!\n");
+    }
+    // A single bad byte after the '[' must be reported exactly like "parse" would:
+    corrupted = input;
+    corrupted[2 + std::rand() % (corrupted.size() - 2)] = corruptions[std::rand() % sizeof(corruptions)];
+    checkJson = GlideJson::parse(corrupted);
+    stream.clear();
+    stream.str(corrupted);
+    GlideJsonArrayReader corruptedReader(stream, 1 + std::rand() % 64);
+    testJson = GlideJson();
+    count = 0;
+    while(corruptedReader.next(testJson) && testJson.notError()) {
+      ++count;
+    }
+    if(checkJson.isError() ? (!testJson.isError() || (testJson.error() != checkJson.error())) : (testJson.isError() || (count != checkJson.array().size()))) {
+      GlideJsonTest::errors.push_back("The corrupted JSON array:\n\n" + corrupted + "\n\n... was not streamed like it is parsed:\n\n" + (testJson.isError() ? testJson.error() : std::string("No error")) + "\n");
+    }
+    if(corruptedReader.next(testJson)) {
+      GlideJsonTest::errors.push_back("A streamed JSON array went on after an error!\n");
+    }
+  }
+  while(--i > 0);
+  // Anything but an array is rejected where it starts:
+  stream.clear();
+  stream.str("\t{\"a\":1}");
+  GlideJsonArrayReader objectReader(stream);
+  if(!objectReader.next(testJson) || !testJson.isError() || (testJson.error() != "Parsing failed at index 1!")) {
+    GlideJsonTest::errors.push_back("A streamed JSON object was not rejected properly!\n");
+  }
+  #ifdef GLIDE_JSON_POSIX
+  const char *path("GlideJsonTest.json");
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  file << "[1, \"two\", [3], {\"four\": 4}] ";
+  file.close();
+  int descriptor(open(path, O_RDONLY));
+  GlideJsonArrayReader descriptorReader(descriptor);
+  input.clear();
+  while(descriptorReader.next(testJson)) {
+    input += testJson.toJson() + ";";
+  }
+  close(descriptor);
+  std::remove(path);
+  if(input != "1;\"two\";[3];{\"four\":4};") {
+    GlideJsonTest::errors.push_back("A JSON array was not streamed from a file descriptor properly:\n\n" + input + "\n");
+  }
+  #endif
+  std::cout << "JSON array reader test: " << (std::chrono::steady_clock::now() - start).count() << "\n";
+}
+
+void GlideJsonTest::measure(const GlideJson &input, size_t depth, GlideJsonLimits &output) {
+  output.depth = std::max(output.depth, depth);
+  ++output.nodes;
+  switch(input.getType()) {
+    case GlideJson::Number:
+      output.length = std::max(output.length, input.number().size());
+      break;
+    case GlideJson::String:
+      output.length = std::max(output.length, input.string().size());
+      break;
+    case GlideJson::Array:
+      output.depth = std::max(output.depth, depth + 1);
+      for(const GlideJson &element : input.array()) {
+        GlideJsonTest::measure(element, depth + 1, output);
+      }
+      break;
+    case GlideJson::Object:
+      output.depth = std::max(output.depth, depth + 1);
+      for(auto i(input.object().begin()); i != input.object().end(); i.next()) {
+        output.length = std::max(output.length, i.key().size());
+        GlideJsonTest::measure(i.value(), depth + 1, output);
+      }
+      break;
+    default:
+      break;
+  }
+}
+
+void GlideJsonTest::testJsonLimits() {
+  std::pair<std::string, std::string> generated;
+  GlideJsonLimits limits;
+  GlideJsonLimits exact;
+  GlideJsonParser parser;
+  GlideJson testJson;
+  std::string expected;
+  unsigned int i(1000);
+  auto start(std::chrono::steady_clock::now());
+  do {
+    generated = GlideJsonTest::generateJsonWithWs();
+    exact.depth = 0;
+    exact.length = 0;
+    exact.nodes = 0;
+    GlideJsonTest::measure(GlideJson::parse(generated.first), 0, exact);
+    // The root doesn't count:
+    --exact.nodes;
+    // Exactly what the document needs is enough:
+    testJson = GlideJson::parse(generated.second, exact);
+    if(testJson.toJson() != generated.first) {
+      GlideJsonTest::errors.push_back("The generated JSON:\n\n" + generated.second + "\n\n... was not parsed within its own limits:\n\n" + (testJson.isError() ? testJson.error() : testJson.toJson()) + "\n");
+    }
+    // One less of any of them isn't:
+    limits = exact;
+    switch(std::rand() % 3) {
+      case 0:
+        if(!exact.depth) {
+          continue;
+        }
+        --limits.depth;
+        expected = "Maximum depth exceeded";
+        break;
+      case 1:
+        if(!exact.length) {
+          continue;
+        }
+        --limits.length;
+        expected = "Maximum length exceeded";
+        break;
+      default:
+        if(!exact.nodes) {
+          continue;
+        }
+        --limits.nodes;
+        expected = "Maximum node count exceeded";
+    }
+    parser.setLimits(limits);
+    GlideJsonTest::feedInChunks(generated.second, parser);
+    testJson = parser.finish();
+    if(!testJson.isError() || (testJson.error().compare(0, expected.size(), expected) != 0)) {
+      GlideJsonTest::errors.push_back("The generated JSON:\n\n" + generated.second + "\n\n... was not stopped by " + expected + ":\n\n" + (testJson.isError() ? testJson.error() : testJson.toJson()) + "\n");
+    }
+  }
+  while(--i > 0);
+  // Strings made of escape sequences or multibyte characters only, and views:
+  limits = GlideJsonLimits();
+  limits.length = 3;
+  if(
+    (GlideJson::parse("[\"\\n\\t\\r\\b\"]", limits).error() != "Maximum length exceeded at index 10!")
+    || (GlideJson::parse("\"\xC3\xA9\xC3\xA9\"", limits).error() != "Maximum length exceeded at index 4!")
+    || (GlideJson::parse("{\"abcd\":1}", limits).error() != "Maximum length exceeded at index 1!")
+    || (GlideJson::parseShared(std::string("[\"abc\",\"abcd\"]")).toJson() != "[\"abc\",\"abcd\"]")
+  ) {
+    GlideJsonTest::errors.push_back("Long strings were not stopped by the length limit!\n");
+  }
+  // A budget too small for a long string stops it right away:
+  limits = GlideJsonLimits();
+  limits.bytes = 1000;
+  testJson = GlideJson::parse("[\"" + std::string(100000, 'x') + "\"]", limits);
+  if(!testJson.isError() || (testJson.error().compare(0, 28, "Maximum byte budget exceeded") != 0) || (std::stoul(testJson.error().substr(38)) > 1000)) {
+    GlideJsonTest::errors.push_back("A long string was not stopped by the byte budget:\n\n" + (testJson.isError() ? testJson.error() : std::string("No error")) + "\n");
+  }
+  // Invalid input is still reported as such:
+  limits = GlideJsonLimits();
+  limits.depth = 1;
+  if((GlideJson::parse("[1,]", limits).error() != "Parsing failed at index 3!") || (GlideJson::parse("[[]]", limits).error() != "Maximum depth exceeded at index 1!")) {
+    GlideJsonTest::errors.push_back("Invalid JSON was not told apart from exceeded limits!\n");
+  }
+  // The limits passed to "parse" don't stay behind:
+  if(GlideJson::parse("[[[[1]]]]").isError()) {
+    GlideJsonTest::errors.push_back("Limits were left behind after a parse!\n");
+  }
+  std::cout << "JSON limits test: " << (std::chrono::steady_clock::now() - start).count() << "\n";
+}
+
+void GlideJsonTest::testJsonToBuffer() {
+  static const GlideJson::Whitespace types[] = {GlideJson::SpaceLf, GlideJson::TabLf, GlideJson::SpaceCrlf, GlideJson::TabCrlf};
+  std::pair<std::string, std::string> generated;
+  GlideJson testJson;
+  std::string buffer;
+  size_t capacity;
+  GlideJson::Whitespace type;
+  unsigned int i;
+  auto start(std::chrono::steady_clock::now());
+  i = 5000;
+  do {
+    generated = GlideJsonTest::generateJsonWithWs();
+    testJson = GlideJson::parse(generated.first);
+    capacity = buffer.capacity();
+    testJson.toJson(buffer);
+    if(buffer != generated.first) {
+      GlideJsonTest::errors.push_back("The generated JSON:\n\n" + generated.first + "\n\n... serialized into a reused buffer does not match:\n\n" + buffer + "\n");
+    }
+    else if(buffer.capacity() < capacity) {
+      GlideJsonTest::errors.push_back("The generated JSON:\n\n" + generated.first + "\n\n... shrank the reused buffer.\n");
+    }
+    else {
+      type = types[std::rand() % 4];
+      testJson.toJson(buffer, type);
+      if(buffer != testJson.toJson(type)) {
+        GlideJsonTest::errors.push_back("The generated JSON:\n\n" + generated.first + "\n\n... pretty-printed into a reused buffer does not match:\n\n" + buffer + "\n");
+      }
+    }
+  }
+  while(--i > 0);
+  std::cout << "JSON to buffer test: " << (std::chrono::steady_clock::now() - start).count() << "\n";
+}
+
+void GlideJsonTest::testJsonSink() {
+  std::pair<std::string, std::string> generated;
+  GlideJson testJson;
+  std::ostringstream stream;
+  std::string collected;
+  size_t capacity;
+  bool chunked;
+  unsigned int i;
+  auto start(std::chrono::steady_clock::now());
+  i = 2000;
+  do {
+    generated = GlideJsonTest::generateJsonWithWs();
+    testJson = GlideJson::parse(generated.first);
+    capacity = 1 + std::rand() % 64;
+    // Every chunk but the last one is exactly "capacity" bytes:
+    collected.clear();
+    chunked = true;
+    GlideJsonSink callbackSink([&](const char *input, size_t size) {
+      chunked = chunked && ((size == capacity) || (collected.size() + size == generated.first.size()));
+      collected.append(input, size);
+      return true;
+    }, capacity);
+    if(!testJson.toJson(callbackSink) || (collected != generated.first) || !chunked) {
+      GlideJsonTest::errors.push_back("The generated JSON:\n\n" + generated.first + "\n\n... was not streamed to a callback properly:\n\n" + collected + "\n");
+    }
+    stream.str("");
+    GlideJsonSink streamSink(stream, capacity);
+    if(!testJson.toJson(streamSink, GlideJson::SpaceLf) || (stream.str() != testJson.toJson(GlideJson::SpaceLf))) {
+      GlideJsonTest::errors.push_back("The generated JSON:\n\n" + generated.first + "\n\n... was not streamed to a std::ostream properly:\n\n" + stream.str() + "\n");
+    }
+  }
+  while(--i > 0);
+  // A failing callback fails the whole serialization:
+  testJson = GlideJson::parse("[\"abcdefgh\",\"ijklmnop\",\"qrstuvwx\"]");
+  collected.clear();
+  GlideJsonSink failingSink([&](const char *input, size_t size) {
+    collected.append(input, size);
+    return false;
+  }, 8);
+  if(testJson.toJson(failingSink) || (collected != "[\"abcdef")) {
+    GlideJsonTest::errors.push_back("A failing sink did not stop the output:\n\n" + collected + "\n");
+  }
+  #ifdef GLIDE_JSON_POSIX
+  const char *path("GlideJsonTest.json");
+  int descriptor(open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644));
+  GlideJsonSink descriptorSink(descriptor, 5);
+  bool written(testJson.toJson(descriptorSink));
+  close(descriptor);
+  std::ifstream file(path, std::ios::binary);
+  collected.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  file.close();
+  std::remove(path);
+  if(!written || (collected != testJson.toJson())) {
+    GlideJsonTest::errors.push_back("A JSON array was not streamed to a file descriptor properly:\n\n" + collected + "\n");
+  }
+  #endif
+  std::cout << "JSON sink test: " << (std::chrono::steady_clock::now() - start).count() << "\n";
+}
+
+void GlideJsonTest::testJsonMeasure() {
+  static const GlideJson::Whitespace types[] = {GlideJson::SpaceLf, GlideJson::TabLf, GlideJson::SpaceCrlf, GlideJson::TabCrlf};
+  std::pair<std::string, std::string> generated;
+  GlideJson testJson;
+  std::string expected;
+  std::string memory;
+  size_t capacity;
+  size_t length;
+  GlideJson::Whitespace type;
+  unsigned int i;
+  auto start(std::chrono::steady_clock::now());
+  i = 5000;
+  do {
+    generated = GlideJsonTest::generateJsonWithWs();
+    testJson = GlideJson::parse(generated.first);
+    type = types[std::rand() % 4];
+    expected = testJson.toJson(type);
+    if((testJson.measureJson() != generated.first.size()) || (testJson.measureJson(type) != expected.size())) {
+      GlideJsonTest::errors.push_back("The generated JSON:\n\n" + generated.first + "\n\n... was not measured properly.\n");
+    }
+    // The byte past "capacity" must never be written:
+    capacity = expected.size() - std::rand() % 2 * (std::rand() % expected.size());
+    memory.assign(capacity + 1, '~');
+    length = testJson.toJson(&(memory[0]), capacity, type);
+    if((length != expected.size()) || (memory[capacity] != '~') || (memory.compare(0, capacity, expected, 0, capacity) != 0)) {
+      GlideJsonTest::errors.push_back("The generated JSON:\n\n" + generated.first + "\n\n... was not written into memory properly:\n\n" + memory + "\n");
+    }
+  }
+  while(--i > 0);
+  std::cout << "JSON measure test: " << (std::chrono::steady_clock::now() - start).count() << "\n";
+}
+
+void GlideJsonTest::testJsonStyle() {
+  std::pair<std::string, std::string> generated;
+  GlideJson testJson;
+  GlideJsonStyle style;
+  std::string testEncoded;
+  unsigned int i;
+  auto start(std::chrono::steady_clock::now());
+  i = 5000;
+  do {
+    generated = GlideJsonTest::generateJsonWithWs();
+    testJson = GlideJson::parse(generated.first);
+    style.width = std::rand() % 300;
+    style.tabs = std::rand() % 2;
+    style.crlf = std::rand() % 2;
+    style.inlineArrays = std::rand() % 4;
+    testEncoded = testJson.toJson(style);
+    if((testJson.measureJson(style) != testEncoded.size()) || (GlideJson::parse(testEncoded).toJson() != generated.first)) {
+      GlideJsonTest::errors.push_back("The generated JSON:\n\n" + generated.first + "\n\n... was not pretty-printed properly:\n\n" + testEncoded + "\n");
+    }
+  }
+  while(--i > 0);
+  testJson = GlideJson::parse("{\"a\":[1,\"b\",null],\"c\":[[2],[]],\"d\":[true,false,3,4]}");
+  if(testJson.toJson(GlideJsonStyle(GlideJson::TabCrlf)) != testJson.toJson(GlideJson::TabCrlf)) {
+    GlideJsonTest::errors.push_back("A GlideJsonStyle does not match its GlideJson::Whitespace.\n");
+  }
+  style = GlideJsonStyle();
+  style.width = 3;
+  style.inlineArrays = 3;
+  testEncoded = testJson.toJson(style);
+  if(testEncoded != "{\n   \"a\": [1, \"b\", null],\n   \"c\": [\n      [2],\n      []\n   ],\n   \"d\": [\n      true,\n      false,\n      3,\n      4\n   ]\n}") {
+    GlideJsonTest::errors.push_back("Short arrays were not kept on one line:\n\n" + testEncoded + "\n");
+  }
+  std::cout << "JSON style test: " << (std::chrono::steady_clock::now() - start).count() << "\n";
+}
+
+void GlideJsonTest::testJsonKeyMemo() {
+  std::pair<std::string, std::string> generated;
+  GlideJson testJson;
+  GlideJson testCopy;
+  std::string results[4];
+  unsigned int i;
+  auto start(std::chrono::steady_clock::now());
+  i = 2000;
+  do {
+    generated = GlideJsonTest::generateJsonWithWs();
+    testJson = GlideJson::parse(generated.first);
+    // The same document serialized by several threads at once:
+    std::thread threads[4];
+    for(size_t j(0); j < 4; ++j) {
+      threads[j] = std::thread([&, j]() {
+        results[j] = testJson.toJson();
+      });
+    }
+    for(size_t j(0); j < 4; ++j) {
+      threads[j].join();
+      if(results[j] != generated.first) {
+        GlideJsonTest::errors.push_back("The generated JSON:\n\n" + generated.first + "\n\n... does not match when serialized concurrently:\n\n" + results[j] + "\n");
+      }
+    }
+    testCopy = testJson;
+    if((testCopy.toJson() != generated.first) || (testJson.toJson(GlideJson::TabLf) != GlideJson::parse(generated.second).toJson(GlideJson::TabLf))) {
+      GlideJsonTest::errors.push_back("The generated JSON:\n\n" + generated.first + "\n\n... does not match once its keys were memoized.\n");
+    }
+  }
+  while(--i > 0);
+  // Replaced and reparsed keys are encoded anew:
+  testJson = GlideJson::parse("{\"a\\n\":1,\"b\\u0000\":2,\"c\":3}");
+  testJson.toJson();
+  testJson.object().erase("b");
+  testJson.object().erase(std::string("b\0", 2));
+  testJson.object()["b\t"] = 4;
+  if(testJson.toJson() != "{\"a\\n\":1,\"c\":3,\"b\\t\":4}") {
+    GlideJsonTest::errors.push_back("Memoized keys do not follow changes to the object:\n\n" + testJson.toJson() + "\n");
+  }
+  GlideJson::parseInto(testJson, "{\"a\\n\":5,\"d\\\\\":6}");
+  if(testJson.toJson() != "{\"a\\n\":5,\"d\\\\\":6}") {
+    GlideJsonTest::errors.push_back("Memoized keys do not follow a reparse:\n\n" + testJson.toJson() + "\n");
+  }
+  std::cout << "JSON key memo test: " << (std::chrono::steady_clock::now() - start).count() << "\n";
+}
+
+void GlideJsonTest::testJsonRemember() {
+  std::pair<std::string, std::string> generated;
+  GlideJson testJson;
+  GlideJson testCopy;
+  std::string results[4];
+  std::string expected;
+  unsigned int i;
+  // Reaching the children turns remembering off, so it's turned on after:
+  std::function<void(GlideJson &)> rememberAll([&](GlideJson &input) {
+    if(input.getType() == GlideJson::Array) {
+      for(auto &j : input.array()) {
+        rememberAll(j);
+      }
+      input.rememberJson(true);
+    }
+    else if(input.getType() == GlideJson::Object) {
+      for(auto j(input.object().begin()); j != input.object().end(); j.next()) {
+        rememberAll(j.value());
+      }
+      input.rememberJson(true);
+    }
+  });
+  auto start(std::chrono::steady_clock::now());
+  i = 2000;
+  do {
+    generated = GlideJsonTest::generateJsonWithWs();
+    testJson = GlideJson::parse(generated.first);
+    rememberAll(testJson);
+    // The first serializations race to remember their bytes:
+    std::thread threads[4];
+    for(size_t j(0); j < 4; ++j) {
+      threads[j] = std::thread([&, j]() {
+        results[j] = testJson.toJson();
+      });
+    }
+    for(size_t j(0); j < 4; ++j) {
+      threads[j].join();
+      if(results[j] != generated.first) {
+        GlideJsonTest::errors.push_back("The generated JSON:\n\n" + generated.first + "\n\n... does not match when remembered concurrently:\n\n" + results[j] + "\n");
+      }
+    }
+    testCopy = testJson;
+    if((testJson.toJson() != generated.first) || (testCopy.toJson() != generated.first) || (testJson.measureJson() != generated.first.size())) {
+      GlideJsonTest::errors.push_back("The generated JSON:\n\n" + generated.first + "\n\n... does not match once remembered.\n");
+    }
+    if(testJson.toJson(GlideJson::TabLf) != GlideJson::parse(generated.second).toJson(GlideJson::TabLf)) {
+      GlideJsonTest::errors.push_back("The generated JSON:\n\n" + generated.first + "\n\n... is not pretty printed correctly once remembered.\n");
+    }
+  }
+  while(--i > 0);
+  // Changes anywhere below a remembered container replace its bytes:
+  testJson = GlideJson::parse("{\"a\":[1,{\"b\":2}],\"c\":{\"d\":\"x\"},\"e\":[]}");
+  rememberAll(testJson);
+  testJson.toJson();
+  testJson.object()["a"].array()[1].object()["b"] = 3;
+  testJson.object()["c"].object()["d"].string() += "y";
+  testJson.object()["e"].array().push_back(GlideJson(true));
+  expected = "{\"a\":[1,{\"b\":3}],\"c\":{\"d\":\"xy\"},\"e\":[true]}";
+  if(testJson.toJson() != expected) {
+    GlideJsonTest::errors.push_back("Remembered containers do not follow changes:\n\n" + testJson.toJson() + "\n");
+  }
+  testJson.object()["c"] = GlideJson::parse("[null]");
+  testJson.object()["a"].rememberJson(false);
+  testJson.object()["a"].array().pop_back();
+  expected = "{\"a\":[1],\"c\":[null],\"e\":[true]}";
+  if(testJson.toJson() != expected) {
+    GlideJsonTest::errors.push_back("Remembered containers do not follow assignments:\n\n" + testJson.toJson() + "\n");
+  }
+  GlideJson::parseInto(testJson, "{\"a\":[2],\"c\":[null],\"e\":[false]}");
+  if(testJson.toJson() != "{\"a\":[2],\"c\":[null],\"e\":[false]}") {
+    GlideJsonTest::errors.push_back("Remembered containers do not follow a reparse:\n\n" + testJson.toJson() + "\n");
+  }
+  // References kept across serializations bypass the containers above:
+  testJson = GlideJson::parse("{\"a\":{\"b\":[1,2]},\"c\":[]}");
+  rememberAll(testJson);
+  std::vector<GlideJson> &heldArray(testJson.object()["a"].object()["b"].array());
+  GlideJson &heldValue(testJson.object()["c"]);
+  testJson.toJson();
+  heldArray.push_back(GlideJson(3));
+  if(testJson.toJson() != "{\"a\":{\"b\":[1,2,3]},\"c\":[]}") {
+    GlideJsonTest::errors.push_back("Remembered containers do not follow a held array:\n\n" + testJson.toJson() + "\n");
+  }
+  testJson.toJson();
+  heldValue = GlideJson("x");
+  heldArray.pop_back();
+  if(testJson.toJson() != "{\"a\":{\"b\":[1,2]},\"c\":\"x\"}") {
+    GlideJsonTest::errors.push_back("Remembered containers do not follow a held value:\n\n" + testJson.toJson() + "\n");
+  }
+  rememberAll(testJson);
+  testCopy = testJson;
+  testJson.toJson();
+  if((testJson.toJson() != "{\"a\":{\"b\":[1,2]},\"c\":\"x\"}") || (testCopy.toJson() != testJson.toJson())) {
+    GlideJsonTest::errors.push_back("Remembered containers do not resume remembering:\n\n" + testJson.toJson() + "\n");
+  }
+  // Re-arming the whole tree after every round of changes, then publishing:
+  testJson = GlideJson::parse("{\"a\":{\"b\":[1]},\"c\":[{\"d\":0}]}");
+  testJson.rememberJsonTree(true);
+  i = 0;
+  while(i < 3) {
+    testJson.object()["c"].array()[0].object()["d"] = GlideJson(i);
+    testJson.rememberJsonTree(true);
+    expected = "{\"a\":{\"b\":[1]},\"c\":[{\"d\":" + std::to_string(i) + "}]}";
+    if((testJson.toJson() != expected) || (testJson.toJson() != expected)) {
+      GlideJsonTest::errors.push_back("Remembered trees do not follow changes:\n\n" + testJson.toJson() + "\n");
+    }
+    ++i;
+  }
+  // A reference taken before re-arming goes unnoticed, which shows the bytes are reused:
+  std::vector<GlideJson> &staleArray(testJson.object()["a"].object()["b"].array());
+  testJson.rememberJsonTree(true);
+  testJson.toJson();
+  staleArray.push_back(GlideJson(2));
+  if(testJson.toJson() != expected) {
+    GlideJsonTest::errors.push_back("A remembered tree was not re-armed:\n\n" + testJson.toJson() + "\n");
+  }
+  testJson.rememberJsonTree(false);
+  if(testJson.toJson() != "{\"a\":{\"b\":[1,2]},\"c\":[{\"d\":2}]}") {
+    GlideJsonTest::errors.push_back("A remembered tree was not turned off:\n\n" + testJson.toJson() + "\n");
+  }
+  try {
+    GlideJson(5).rememberJson(true);
+    GlideJsonTest::errors.push_back("A number was asked to remember its serialization!\n");
+  }
+  catch(const GlideError &) {
+  }
+  try {
+    GlideJson("x").rememberJsonTree(true);
+    GlideJsonTest::errors.push_back("A string was asked to remember its serialization!\n");
+  }
+  catch(const GlideError &) {
+  }
+  std::cout << "JSON remember test: " << (std::chrono::steady_clock::now() - start).count() << "\n";
+}
+
 void GlideJsonTest::testJsonInParallel() {
   std::pair<std::string, std::string> generated;
   GlideJson testJson;
@@ -1243,6 +3077,30 @@ int GlideJsonTest::run() {
   GlideJsonTest::testJson();
   GlideJsonTest::testJsonUtf8();
   GlideJsonTest::testJsonContainers();
+  GlideJsonTest::testJsonScanRuns();
+  GlideJsonTest::testJsonScanStrings();
+  GlideJsonTest::testJsonEncodeRuns();
+  GlideJsonTest::testJsonChunks();
+  GlideJsonTest::testJsonHandler();
+  GlideJsonTest::testJsonTape();
+  GlideJsonTest::testJsonShared();
+  GlideJsonTest::testJsonSelector();
+  GlideJsonTest::testJsonValidate();
+  GlideJsonTest::testJsonLines();
+  GlideJsonTest::testJsonParseInto();
+  GlideJsonTest::testJsonIntegers();
+  GlideJsonTest::testJsonDoubles();
+  GlideJsonTest::testJsonShortestDoubles();
+  GlideJsonTest::testJsonParseInParallel();
+  GlideJsonTest::testJsonParseFile();
+  GlideJsonTest::testJsonArrayReader();
+  GlideJsonTest::testJsonLimits();
+  GlideJsonTest::testJsonToBuffer();
+  GlideJsonTest::testJsonSink();
+  GlideJsonTest::testJsonMeasure();
+  GlideJsonTest::testJsonStyle();
+  GlideJsonTest::testJsonKeyMemo();
+  GlideJsonTest::testJsonRemember();
   // Check errors:
   size_t errorCount(GlideJsonTest::errors.size());
   if(errorCount) {